@@ -1,41 +1,89 @@
 #include "assistant.h"
 #include "cube.h"
 #include "sticker_data.h"
+#include "move_parser.h"
+#include "facelet_moves.h"
+#include "compiled_sequence.h"
 #include <iostream>
 #include <string>
 #include <vector>
 #include <map>
 #include <utility>
 #include <sstream>
+#include <functional>
 using namespace std;
 
+namespace {
+    /**
+     * Applies a clockwise rotation to a state, which only changes the orientation it is seen from.
+     * @param state The state to rotate.
+     * @param letter The letter of the rotation, or a space to leave the state unchanged.
+     */
+    void rotate(CubeState& state, char letter) {
+        if (letter != ' ') {
+            state.applyMove(FaceletMoves::getMove(letter, 1));
+        }
+    }
+}
+
+string Assistant::Step::format() const {
+    return message() + "\nMoves: " + MoveParser::toString(moves, true);
+}
+
 Assistant::Assistant(Cube& cube) {
     this->cube = &cube;
+    plan = nullptr;
+    stage = WHITE_CROSS;
 }
 
 void Assistant::solve() {
+    solveStages();
+}
+
+vector<Assistant::Step> Assistant::createPlan() {
+    vector<Step> steps;
+    Cube copy = *cube;
+    Cube* original = cube;
+
+    cube = &copy;
+    plan = &steps;
+    solveStages();
+    cube = original;
+    plan = nullptr;
+
+    return steps;
+}
+
+void Assistant::solveStages() {
     int userNum = -1;
     
     switch (checkStage()) {
         case WHITE_CROSS:
+            stage = WHITE_CROSS;
             userNum = getWhiteCross();
             if (userNum == EXIT) { break; }
         case WHITE_CORNERS:
+            stage = WHITE_CORNERS;
             userNum = getWhiteCorners();
             if (userNum == EXIT) { break; }
         case SECOND_LAYER:
+            stage = SECOND_LAYER;
             userNum = getSecondLayer();
             if (userNum == EXIT) { break; }
         case YELLOW_CROSS:
+            stage = YELLOW_CROSS;
             userNum = getYellowCross();
             if (userNum == EXIT) { break; }
         case YELLOW_EDGES:
+            stage = YELLOW_EDGES;
             userNum = getYellowEdges();
             if (userNum == EXIT) { break; }
         case YELLOW_CORNERS_POSITION:
+            stage = YELLOW_CORNERS_POSITION;
             userNum = getYellowCornersPosition();
             if (userNum == EXIT) { break; }
         case YELLOW_CORNERS_ORIENTATION:
+            stage = YELLOW_CORNERS_ORIENTATION;
             userNum = getYellowCornersOrientation();
             if (userNum == EXIT) { break; }
             printComplete("SOLVED");
@@ -43,6 +91,8 @@ void Assistant::solve() {
 }
 
 int Assistant::prompt(bool allowExiting) const {
+    if (plan != nullptr) { return CONT; } // Plans run every step without asking
+
     string userInput;
     int userNum;
     cout << "Enter" << (allowExiting ? " 0 to exit," : "") << " 1 to skip, or anything else to continue: ";
@@ -60,11 +110,21 @@ int Assistant::prompt(bool allowExiting) const {
     }
 }
 
-bool Assistant::processSequence(const string& sequence, const string& message) {
+bool Assistant::processSequence(const string& sequence, const function<string()>& message) {
+    if (plan != nullptr) {
+        cube->doMoves(sequence, false);
+        if (sequence.length() == 0) { return false; }
+
+        Step step = { stage, {}, message };
+        MoveParser::parse(sequence, &step.moves);
+        plan->push_back(step);
+        return true;
+    }
+
     cube->doMoves(sequence, true);
 
     if (sequence.length() != 0) {
-        cout << "\n" << message << endl << "Moves: " << Cube::tokenizeMoves(sequence);
+        cout << "\n" << message() << endl << "Moves: " << Cube::tokenizeMoves(sequence);
         cube->displayState(false);
         return true;
     } else {
@@ -85,7 +145,7 @@ string Assistant::simplifySequence(const string& sequence) const {
 string Assistant::rotateToFace(int& face, int newFace, bool onlyYMoves) const {
     string sequence = "";
     string tempSequence = "";
-    Cube temp = *cube;
+    CubeState temp = cube->getState();
     int rotationsToCheck = 3;
     char originalCenter = cube->getAt(face, 1, 1); // Keep track of original face's center, as it won't change
 
@@ -97,7 +157,7 @@ string Assistant::rotateToFace(int& face, int newFace, bool onlyYMoves) const {
         }
 
         if (tempSequence.length() == 3) { // Stop at 3 moves and perform the 4th move to reset the state
-            temp.doMoves(tempSequence.substr(0, 1), false);
+            rotate(temp, tempSequence[0]);
             tempSequence = "";
             rotationsToCheck--;
         }
@@ -112,7 +172,7 @@ string Assistant::rotateToFace(int& face, int newFace, bool onlyYMoves) const {
         }
 
         tempSequence += toAdd;
-        temp.doMoves(toAdd, false); // Apply the move and check if it results in the color being on the face
+        rotate(temp, toAdd[0]); // Apply the move and check if it results in the color being on the face
     }
 
     face = newFace;
@@ -152,8 +212,8 @@ string Assistant::turnEdgeToBottom(int& row, int& col) const {
 string Assistant::turnEdgeToFace(int& face, int newFace, int row, int col, bool isOnTop) const {
     string sequence = "";
     string tempSequence = "";
-    string moveToUse = isOnTop ? "U" : "D";
-    Cube temp = *cube;
+    char moveToUse = isOnTop ? 'U' : 'D';
+    CubeState temp = cube->getState();
     char originalColor1 = cube->getAt(face, row, col);
     char originalColor2 = cube->getAdjEdge(face, row, col).color;
     int turnsToCheck = 3;
@@ -171,7 +231,7 @@ string Assistant::turnEdgeToFace(int& face, int newFace, int row, int col, bool
         }
 
         tempSequence += moveToUse;
-        temp.doMoves(moveToUse, false);
+        temp.applyMove(FaceletMoves::getMove(moveToUse, 1));
     }
 
     face = newFace;
@@ -212,8 +272,8 @@ string Assistant::turnEdgetoTop(int& row, int& col) const {
 string Assistant::turnCornerToFaces(char baseColor, const pair<char, char>& colors, int& face, bool isOnTop) const {
     string sequence = "";
     string tempSequence = "";
-    string moveToUse = isOnTop ? "U" : "D";
-    Cube temp = *cube;
+    char moveToUse = isOnTop ? 'U' : 'D';
+    CubeState temp = cube->getState();
     int turnsToCheck = 3;
 
     while (turnsToCheck >= 0) {
@@ -227,7 +287,7 @@ string Assistant::turnCornerToFaces(char baseColor, const pair<char, char>& colo
 
         // Otherwise, keep adding to the sequence.
         tempSequence += moveToUse;
-        temp.doMoves(moveToUse, false);
+        temp.applyMove(FaceletMoves::getMove(moveToUse, 1));
 
         // Update the face with each turn.
         // The faces wrap around to 1 after the 4th index (1-4).
@@ -256,6 +316,8 @@ char Assistant::getSideColor(char color, const pair<char, char>& adjColors) cons
 }
 
 void Assistant::printComplete(const string& message) const {
+    if (plan != nullptr) { return; }
+
     const int TOTAL_WIDTH = 80;
     int remaining = (TOTAL_WIDTH - message.length());
     int width1, width2;
@@ -311,7 +373,7 @@ int Assistant::getWhiteCross() {
 
     // Get the white center face up.
     int face = cube->findCenter('W');
-    processed = processSequence(rotateToFace(face, Cube::TOP, false), "[WHITE CROSS] Rotate the cube so that the white center is on the top.");
+    processed = processSequence(rotateToFace(face, Cube::TOP, false), [] { return "[WHITE CROSS] Rotate the cube so that the white center is on the top."; });
     if (processed) {
         userNum = prompt(true);
         if (userNum == EXIT) { return EXIT; }
@@ -337,10 +399,10 @@ int Assistant::getWhiteCross() {
             StickerData correctEdge = cube->findEdge('W', correctFaceColor);
             StickerData adjEdge = cube->getAdjEdge(correctEdge.face, correctEdge.row, correctEdge.col);
             StickerData useEdge = pickOutward({ correctEdge, adjEdge }); // Only use the edge that appears in front
-            string edgeColors = Cube::getColors({ correctEdge.color, adjEdge.color }) + " edge";
+            auto edgeColors = [=] { return Cube::getColors({ correctEdge.color, adjEdge.color }) + " edge"; };
             
             // Rotate the Cube so that the edge is in front.
-            processed = processSequence(rotateToFace(useEdge.face, Cube::FRONT, true), "[WHITE CROSS] Rotate the cube so that the " + edgeColors + " is in front.");
+            processed = processSequence(rotateToFace(useEdge.face, Cube::FRONT, true), [=] { return "[WHITE CROSS] Rotate the cube so that the " + edgeColors() + " is in front."; });
             if (processed && userNum != SKIP) {
                 userNum = prompt(true);
                 if (userNum == EXIT) { return EXIT; }
@@ -349,7 +411,7 @@ int Assistant::getWhiteCross() {
             // Check if the edge is in the correct position.
             int correctFace = cube->findCenter(correctFaceColor);
             if (useEdge.face != correctFace) {
-                processed = processSequence(turnEdgeToBottom(useEdge.row, useEdge.col), "[WHITE CROSS] Position the " + edgeColors + " on the bottom.");
+                processed = processSequence(turnEdgeToBottom(useEdge.row, useEdge.col), [=] { return "[WHITE CROSS] Position the " + edgeColors() + " on the bottom."; });
                 if (processed && userNum != SKIP) {
                     userNum = prompt(true);
                     if (userNum == EXIT) { return EXIT; }
@@ -357,14 +419,14 @@ int Assistant::getWhiteCross() {
 
                 // Turn the bottom face to position it on the correct face.
                 processed = processSequence(turnEdgeToFace(useEdge.face, correctFace, useEdge.row, useEdge.col, false),
-                                "[WHITE CROSS] Turn the bottom face to position the " + edgeColors + " on the " + Cube::FACE_STRINGS.at(correctFace) + " face.");
+                                [=] { return "[WHITE CROSS] Turn the bottom face to position the " + edgeColors() + " on the " + Cube::FACE_STRINGS.at(correctFace) + " face."; });
                 if (processed && userNum != SKIP) {
                     userNum = prompt(true);
                     if (userNum == EXIT) {return EXIT; }
                 }
 
                 // Rotate the Cube so that the edge is once again in front.
-                processed = processSequence(rotateToFace(useEdge.face, Cube::FRONT, true), "[WHITE CROSS] Rotate the cube so that the " + edgeColors + " is in front again.");
+                processed = processSequence(rotateToFace(useEdge.face, Cube::FRONT, true), [=] { return "[WHITE CROSS] Rotate the cube so that the " + edgeColors() + " is in front again."; });
                 if (processed && userNum != SKIP) {
                     userNum = prompt(true);
                     if (userNum == EXIT) {
@@ -379,29 +441,29 @@ int Assistant::getWhiteCross() {
             int row = useEdge.row;
             int col = useEdge.col;
             string algorithm = "";
-            string message = "";
+            function<string()> message;
 
             if (color == 'W' && row == 0 && col == 1) { // Edge is in correct spot but needs to be oriented
                 algorithm = "FU'RU";
-                message = "[WHITE CROSS] Perform an algorithm to orient the " + edgeColors + " correctly.";
+                message = [=] { return "[WHITE CROSS] Perform an algorithm to orient the " + edgeColors() + " correctly."; };
             } else if (color == 'W' && row == 1 && col == 0) { // Edge is on the left, facing front
                 algorithm = "UL'U'";
-                message = "[WHITE CROSS] Perform an algorithm to bring up the " + edgeColors + " from the left.";
+                message = [=] { return "[WHITE CROSS] Perform an algorithm to bring up the " + edgeColors() + " from the left."; };
             } else if (color == 'W' && row == 1 && col == 2) { // Edge is on the right, facing front
                 algorithm = "U'RU";
-                message = "[WHITE CROSS] Perform an algorithm to bring up the " + edgeColors + " from the right.";
+                message = [=] { return "[WHITE CROSS] Perform an algorithm to bring up the " + edgeColors() + " from the right."; };
             } else if (color == 'W' && row == 2 && col == 1) { // Edge is on the bottom, facing front
                 algorithm = "F'U'RU";
-                message = "[WHITE CROSS] Perform an algorithm to bring up the " + edgeColors + " from the bottom.";
+                message = [=] { return "[WHITE CROSS] Perform an algorithm to bring up the " + edgeColors() + " from the bottom."; };
             } else if (color != 'W' && row == 1 && col == 0) { // Edge is on the left, facing left
                 algorithm = "F";
-                message = "[WHITE CROSS] Use a move to bring up the " + edgeColors + " from the left.";
+                message = [=] { return "[WHITE CROSS] Use a move to bring up the " + edgeColors() + " from the left."; };
             } else if (color != 'W' && row == 1 && col == 2) { // Edge is on the right, facing right
                 algorithm = "F'";
-                message = "[WHITE CROSS] Use a move to bring up the " + edgeColors + " from the right.";
+                message = [=] { return "[WHITE CROSS] Use a move to bring up the " + edgeColors() + " from the right."; };
             } else { // Edge is on the bottom, facing down
                 algorithm = "F2";
-                message = "[WHITE CROSS] Use two moves to bring up the " + edgeColors + " from the bottom.";
+                message = [=] { return "[WHITE CROSS] Use two moves to bring up the " + edgeColors() + " from the bottom."; };
             }
 
             processed = processSequence(algorithm, message);
@@ -459,7 +521,7 @@ int Assistant::getWhiteCorners() {
 
     // Get the white center face up.
     int face = cube->findCenter('W');
-    processed = processSequence(rotateToFace(face, Cube::TOP, false), "[WHITE CORNERS] Rotate the cube so that the white center is on the top.");
+    processed = processSequence(rotateToFace(face, Cube::TOP, false), [] { return "[WHITE CORNERS] Rotate the cube so that the white center is on the top."; });
     if (processed) {
         userNum = prompt(true);
         if (userNum == EXIT) {return EXIT; }
@@ -491,10 +553,10 @@ int Assistant::getWhiteCorners() {
             pair<StickerData, pair<StickerData, StickerData>> correctCorner = cube->findCorner('W', faceColors);
             pair<char, char> adjCornerColors = { correctCorner.second.first.color, correctCorner.second.second.color };
             StickerData useCorner = pickOutward({ correctCorner.first, correctCorner.second.first, correctCorner.second.second });
-            string cornerColors = Cube::getColors({ correctCorner.first.color, adjCornerColors.first, adjCornerColors.second }) + " corner";
+            auto cornerColors = [=] { return Cube::getColors({ correctCorner.first.color, adjCornerColors.first, adjCornerColors.second }) + " corner"; };
 
             // Rotate the Cube to the corner's position.
-            processed = processSequence(rotateToFace(useCorner.face, Cube::FRONT, true), "[WHITE CORNERS] Rotate the cube so that the " + cornerColors + " is in front.");
+            processed = processSequence(rotateToFace(useCorner.face, Cube::FRONT, true), [=] { return "[WHITE CORNERS] Rotate the cube so that the " + cornerColors() + " is in front."; });
             if (processed && userNum != SKIP) {
                 userNum = prompt(true);
                 if (userNum == EXIT) { return EXIT; }
@@ -503,7 +565,7 @@ int Assistant::getWhiteCorners() {
             // Check if the corner is between its proper faces.
             if (!cube->checkCornerPosition('W', adjCornerColors)) {
                 // Position the corner to the bottom.
-                processed = processSequence(turnCornerToBottom(useCorner.row, useCorner.col), "[WHITE CORNERS] Position the " + cornerColors + " on the bottom.");
+                processed = processSequence(turnCornerToBottom(useCorner.row, useCorner.col), [=] { return "[WHITE CORNERS] Position the " + cornerColors() + " on the bottom."; });
                 if (processed && userNum != SKIP) {
                     userNum = prompt(true);
                     if (userNum == EXIT) { return EXIT; }
@@ -512,16 +574,16 @@ int Assistant::getWhiteCorners() {
                 // Turn the corner to the correct faces.
                 int face1 = cube->findCenter(faceColors.first); // Locate the correct faces as they may have changed due to rotation
                 int face2 = cube->findCenter(faceColors.second);
-                string cornerFaces = Cube::getFaces({ face1, face2 }) + " faces";
+                auto cornerFaces = [=] { return Cube::getFaces({ face1, face2 }) + " faces"; };
                 processed = processSequence(turnCornerToFaces('W', adjCornerColors, useCorner.face, false),
-                                "[WHITE CORNERS] Turn the bottom face to position the " + cornerColors + " on the " + cornerFaces + ".");
+                                [=] { return "[WHITE CORNERS] Turn the bottom face to position the " + cornerColors() + " on the " + cornerFaces() + "."; });
                 if (processed && userNum != SKIP) {
                     userNum = prompt(true);
                     if (userNum == EXIT) { return EXIT; }
                 }
 
                 // Rotate the Cube so that the corner is in front again.
-                processSequence(rotateToFace(useCorner.face, Cube::FRONT, true), "[WHITE CORNERS] Rotate the cube so that the " + cornerColors + " is in front again.");
+                processSequence(rotateToFace(useCorner.face, Cube::FRONT, true), [=] { return "[WHITE CORNERS] Rotate the cube so that the " + cornerColors() + " is in front again."; });
                 if (processed && userNum != SKIP) {
                     userNum = prompt(true);
                     if (userNum == EXIT) { return EXIT; }
@@ -534,38 +596,38 @@ int Assistant::getWhiteCorners() {
             int row = useCorner.row;
             int col = useCorner.col;
             string algorithm = "";
-            string message = "";
+            function<string()> message;
             
             if (color == 'W' && row == 0 && col == 0) { // Corner in top left, facing front
                 algorithm = "LD'L'F'D'F";
-                message = "[WHITE CORNERS] Use an algorithm to orient the " + cornerColors + " on the top left.";
+                message = [=] { return "[WHITE CORNERS] Use an algorithm to orient the " + cornerColors() + " on the top left."; };
             } else if (color == 'W' && row == 0 && col == 2) { // Corner in top right, facing front
                 algorithm = "R'DRFDF'";
-                message = "[WHITE CORNERS] Use an algorithm to orient the " + cornerColors + " on the top right.";
+                message = [=] { return "[WHITE CORNERS] Use an algorithm to orient the " + cornerColors() + " on the top right."; };
             } else if (color == 'W' && row == 2 && col == 0) { // Corner in bottom left, facing front
                 algorithm = "F'D'F";
-                message = "[WHITE CORNERS] Use an algorithm to bring up the " + cornerColors + " from the bottom left.";
+                message = [=] { return "[WHITE CORNERS] Use an algorithm to bring up the " + cornerColors() + " from the bottom left."; };
             } else if (color == 'W' && row == 2 && col == 2) { // Corner in bottom right, facing front
                 algorithm = "FDF'";
-                message = "[WHITE CORNERS] Use an algorithm to bring up the " + cornerColors + " from the bottom right.";
+                message = [=] { return "[WHITE CORNERS] Use an algorithm to bring up the " + cornerColors() + " from the bottom right."; };
             } else if (color != 'W' && sideColor == 'W' && row == 0 && col == 0) { // Corner in top left, facing left
                 algorithm = "LDL'D'LDL'";
-                message = "[WHITE CORNERS] Use an algorithm to orient the " + cornerColors + " on the top left.";
+                message = [=] { return "[WHITE CORNERS] Use an algorithm to orient the " + cornerColors() + " on the top left."; };
             } else if (color != 'W' && sideColor == 'W' && row == 0 && col == 2) { // Corner in top right, facing right
                 algorithm = "R'D'RDR'D'R";
-                message = "[WHITE CORNERS] Use an algorithm to orient the " + cornerColors + " on the top right.";
+                message = [=] { return "[WHITE CORNERS] Use an algorithm to orient the " + cornerColors() + " on the top right."; };
             } else if (color != 'W' && sideColor == 'W' && row == 2 && col == 0) { // Corner in bottom left, facing left
                 algorithm = "LDL'";
-                message = "[WHITE CORNERS] Use an algorithm to bring up the " + cornerColors + " from the bottom left.";
+                message = [=] { return "[WHITE CORNERS] Use an algorithm to bring up the " + cornerColors() + " from the bottom left."; };
             } else if (color != 'W' && sideColor == 'W' && row == 2 && col == 2) { // Corner in bottom right, facing right
                 algorithm = "R'D'R";
-                message = "[WHITE CORNERS] Use an algorithm to bring up the " + cornerColors + " from the bottom right.";
+                message = [=] { return "[WHITE CORNERS] Use an algorithm to bring up the " + cornerColors() + " from the bottom right."; };
             } else if (color != 'W' && sideColor != 'W' && row == 2 && col == 0) { // Corner in bottom left, facing down
                 algorithm = "LD'L'F'D2F";
-                message = "[WHITE CORNERS] Use an algorithm to bring up the " + cornerColors + " from the bottom left.";
+                message = [=] { return "[WHITE CORNERS] Use an algorithm to bring up the " + cornerColors() + " from the bottom left."; };
             } else { // Corner in bottom right, facing down
                 algorithm = "R'DRFD2F'";
-                message = "[WHITE CORNERS] Use an algorithm to bring up the " + cornerColors + " from the bottom right.";
+                message = [=] { return "[WHITE CORNERS] Use an algorithm to bring up the " + cornerColors() + " from the bottom right."; };
             }
 
             processed = processSequence(algorithm, message);
@@ -635,7 +697,7 @@ int Assistant::getSecondLayer() {
 
     // Get the yellow center up.
     int face = cube->findCenter('Y');
-    processed = processSequence(rotateToFace(face, Cube::TOP, false), "[SECOND LAYER] Rotate the cube so that the yellow center is on the top.");
+    processed = processSequence(rotateToFace(face, Cube::TOP, false), [] { return "[SECOND LAYER] Rotate the cube so that the yellow center is on the top."; });
     if (processed) {
         userNum = prompt(true);
         if (userNum == EXIT) { return EXIT; }
@@ -661,10 +723,10 @@ int Assistant::getSecondLayer() {
             StickerData correctEdge = cube->findEdge(faceColors.first, faceColors.second);
             StickerData adjEdge = cube->getAdjEdge(correctEdge.face, correctEdge.row, correctEdge.col);
             StickerData useEdge = pickOutward({ correctEdge, adjEdge });
-            string edgeColors = Cube::getColors({ correctEdge.color, adjEdge.color }) + " edge";
+            auto edgeColors = [=] { return Cube::getColors({ correctEdge.color, adjEdge.color }) + " edge"; };
 
             // Rotate to the edge's position.
-            processed = processSequence(rotateToFace(useEdge.face, Cube::FRONT, true), "[SECOND LAYER] Rotate the cube so that the " + edgeColors + " is in front.");
+            processed = processSequence(rotateToFace(useEdge.face, Cube::FRONT, true), [=] { return "[SECOND LAYER] Rotate the cube so that the " + edgeColors() + " is in front."; });
             if (processed && userNum != SKIP) {
                 userNum = prompt(true);
                 if (userNum == EXIT) { return EXIT; }
@@ -673,7 +735,7 @@ int Assistant::getSecondLayer() {
             // Check if the edge is in the right position.
             if (!checkSecondLayerPosition(useEdge, cube->getAdjEdge(useEdge.face, useEdge.row, useEdge.col))) {
                 // Position the edge up to move it to the proper face.
-                processed = processSequence(turnEdgetoTop(useEdge.row, useEdge.col), "[SECOND LAYER] Position the " + edgeColors + " on top.");
+                processed = processSequence(turnEdgetoTop(useEdge.row, useEdge.col), [=] { return "[SECOND LAYER] Position the " + edgeColors() + " on top."; });
                 if (processed && userNum != SKIP) {
                     userNum = prompt(true);
                     if (userNum == EXIT) { return EXIT; }
@@ -686,15 +748,15 @@ int Assistant::getSecondLayer() {
                 // The new face is calculated using the front-facing edge, as its center color
                 // needs to match the center color of its new face.
                 int useFace = (useEdge.color == correctEdge.color) ? face1 : face2;
-                string edgeFaces = cube->getFaces({ face1, face2 }) + " faces";
-                processed = processSequence(turnEdgeToFace(useEdge.face, useFace, useEdge.row, useEdge.col, true), "[SECOND LAYER] Turn the upper face to move the " + edgeColors + " to the " + edgeFaces + ".");
+                auto edgeFaces = [=] { return Cube::getFaces({ face1, face2 }) + " faces"; };
+                processed = processSequence(turnEdgeToFace(useEdge.face, useFace, useEdge.row, useEdge.col, true), [=] { return "[SECOND LAYER] Turn the upper face to move the " + edgeColors() + " to the " + edgeFaces() + "."; });
                 if (processed && userNum != SKIP) {
                     userNum = prompt(true);
                     if (userNum == EXIT) { return EXIT; }
                 }
 
                 // Rotate to the new face.
-                processed = processSequence(rotateToFace(useEdge.face, Cube::FRONT, true), "[SECOND LAYER] Rotate the cube so that the " + edgeColors + " is in front again.");
+                processed = processSequence(rotateToFace(useEdge.face, Cube::FRONT, true), [=] { return "[SECOND LAYER] Rotate the cube so that the " + edgeColors() + " is in front again."; });
                 if (processed && userNum != SKIP) {
                     userNum = prompt(true);
                     if (userNum == EXIT) { return EXIT; }
@@ -707,20 +769,20 @@ int Assistant::getSecondLayer() {
             int row = useEdge.row;
             int col = useEdge.col;
             string algorithm = "";
-            string message = "";
+            function<string()> message;
 
             if (faceSlot < Cube::FRONT && row == 0 && col == 1) { // Edge is on the top and needs to be moved to the left
                 algorithm = "U'L'ULUFU'F'";
-                message = "[SECOND LAYER] Use an algorithm to bring down the " + edgeColors + " from the top to the left.";
+                message = [=] { return "[SECOND LAYER] Use an algorithm to bring down the " + edgeColors() + " from the top to the left."; };
             } else if (faceSlot > Cube::FRONT && row == 0 && col == 1) { // Edge is on the top and needs to be moved to the right
                 algorithm = "URU'R'U'F'UF";
-                message = "[SECOND LAYER] Use an algorithm to bring down the " + edgeColors + " from the top to the right.";
+                message = [=] { return "[SECOND LAYER] Use an algorithm to bring down the " + edgeColors() + " from the top to the right."; };
             } else if (row == 1 && col == 0) { // Edge is in the correct left slot and needs to be oriented in place
                 algorithm = "L'ULU'FU2F'U'FU2F'";
-                message = "[SECOND LAYER] Use an algorithm to orient the " + edgeColors + " correctly on the left.";
+                message = [=] { return "[SECOND LAYER] Use an algorithm to orient the " + edgeColors() + " correctly on the left."; };
             } else { // Edge is in the correct right slot and needs to be oriented in place.
                 algorithm = "RU'R'UF'U2FUF'U2F";
-                message = "[SECOND LAYER] Use an algorithm to orient the " + edgeColors + " correctly on the right.";
+                message = [=] { return "[SECOND LAYER] Use an algorithm to orient the " + edgeColors() + " correctly on the right."; };
             }
 
             processed = processSequence(algorithm, message);
@@ -756,7 +818,7 @@ int Assistant::getYellowCross() {
 
     // Get the yellow center facing up.
     int face = cube->findCenter('Y');
-    processed = processSequence(rotateToFace(face, Cube::TOP, false), "[YELLOW CROSS] Rotate the cube so that the yellow center is on top.");
+    processed = processSequence(rotateToFace(face, Cube::TOP, false), [] { return "[YELLOW CROSS] Rotate the cube so that the yellow center is on top."; });
     if (processed) {
         userNum = prompt(true);
         if (userNum == EXIT) { return EXIT; }
@@ -765,38 +827,38 @@ int Assistant::getYellowCross() {
     // If the yellow cross has not been achieved, check for various cases and solve them.
     if (!checkYellowCross()) {
         string algorithm = "";
-        string message = "";
+        function<string()> message;
     
         // Check for line shapes first.
         pair<bool, string> shape = checkLineShape();
         if (shape.first) {
-            processed = processSequence(shape.second, "[YELLOW CROSS] Turn the upper face to correctly position the line shape.");
+            processed = processSequence(shape.second, [] { return "[YELLOW CROSS] Turn the upper face to correctly position the line shape."; });
             if (processed && userNum != SKIP) {
                 userNum = prompt(true);
                 if (userNum == EXIT) { return EXIT; }
             }
     
             algorithm = "FRUR'U'F'";
-            message = "[YELLOW CROSS] Perform an algorithm to get the line shape into a cross shape.";
+            message = [] { return "[YELLOW CROSS] Perform an algorithm to get the line shape into a cross shape."; };
         }
     
         // Then, check for L shapes.
         shape = checkLShape();
         if (shape.first) {
-            processed = processSequence(shape.second, "[YELLOW CROSS] Turn the upper face to correctly position the L shape.");
+            processed = processSequence(shape.second, [] { return "[YELLOW CROSS] Turn the upper face to correctly position the L shape."; });
             if (processed && userNum != SKIP) {
                 userNum = prompt(true);
                 if (userNum == EXIT) { return EXIT; }
             }
     
             algorithm = "FURU'R'F'";
-            message = "[YELLOW CROSS] Perform an algorithm to get the L shape into a cross shape.";
+            message = [] { return "[YELLOW CROSS] Perform an algorithm to get the L shape into a cross shape."; };
         }
     
         // Then, check for dot shapes.
         if (checkDotShape()) {
             algorithm = "FRUR'U'F'y2FRUR'U'F'y2FRUR'U'F'";
-            message = "[YELLOW CROSS] Perform two algorithms to get the dot shape into a cross shape.";
+            message = [] { return "[YELLOW CROSS] Perform two algorithms to get the dot shape into a cross shape."; };
         }
     
         processed = processSequence(algorithm, message);
@@ -874,7 +936,7 @@ int Assistant::getYellowEdges() {
 
     // Get the yellow center facing up.
     int face = cube->findCenter('Y');
-    processed = processSequence(rotateToFace(face, Cube::TOP, false), "[YELLOW EDGES] Rotate the cube so that the yellow center is on top.");
+    processed = processSequence(rotateToFace(face, Cube::TOP, false), [] { return "[YELLOW EDGES] Rotate the cube so that the yellow center is on top."; });
     if (processed) {
         userNum = prompt(true);
         if (userNum == EXIT) { return EXIT; }
@@ -887,9 +949,9 @@ int Assistant::getYellowEdges() {
     vector<pair<int, int>> matchCoords = { { matchStickers[0].row, matchStickers[0].col }, { matchStickers[1].row, matchStickers[1].col } };
     char color1 = matchStickers[0].color;
     char color2 = matchStickers[1].color;
-    string matchingEdges = Cube::getColors({ 'Y', color1 }) + " and " + Cube::getColors( { 'Y', color2 }) + " edges";
+    auto matchingEdges = [=] { return Cube::getColors({ 'Y', color1 }) + " and " + Cube::getColors( { 'Y', color2 }) + " edges"; };
 
-    processed = processSequence(matchData.first, "[YELLOW EDGES] Turn the upper face until the " + matchingEdges + " match their adjacent faces' center colors.");
+    processed = processSequence(matchData.first, [=] { return "[YELLOW EDGES] Turn the upper face until the " + matchingEdges() + " match their adjacent faces' center colors."; });
     if (processed && userNum != SKIP) {
         userNum = prompt(true);
         if (userNum == EXIT) { return EXIT; }
@@ -930,32 +992,32 @@ int Assistant::getYellowEdges() {
 
     char incorrect1 = cube->getAdjEdge(face, incorrectCoords[0].first, incorrectCoords[0].second).color;
     char incorrect2 = cube->getAdjEdge(face, incorrectCoords[1].first, incorrectCoords[1].second).color;
-    string incorrectEdges = Cube::getColors({ 'Y', incorrect1 }) + " and " + Cube::getColors({ 'Y', incorrect2 }) + " edges";
+    auto incorrectEdges = [=] { return Cube::getColors({ 'Y', incorrect1 }) + " and " + Cube::getColors({ 'Y', incorrect2 }) + " edges"; };
 
     // Once edges match, rotate the cube to allow the algorithms to work.
     // There is a possibility that all of them may match after, so check for that, too.
     if (!checkYellowEdges()) {
         string algorithm = "";
-        string message = "";
+        function<string()> message;
 
         if (configuration == "OPPOSITE") {
-            processed = processSequence(prepareYellowEdges(configuration, { incorrect1, incorrect2 }), "[YELLOW EDGES] Rotate the cube so that the " + incorrectEdges + " are on the Front and Back faces.");
+            processed = processSequence(prepareYellowEdges(configuration, { incorrect1, incorrect2 }), [=] { return "[YELLOW EDGES] Rotate the cube so that the " + incorrectEdges() + " are on the Front and Back faces."; });
             if (processed && userNum != SKIP) {
                 userNum = prompt(true);
                 if (userNum == EXIT) { return EXIT; }
             }
 
             algorithm = "URUR'URU2R'y2URUR'URU2R'U'";
-            message = "[YELLOW EDGES] Perform two algorithms to swap both the " + incorrectEdges + ".";
+            message = [=] { return "[YELLOW EDGES] Perform two algorithms to swap both the " + incorrectEdges() + "."; };
         } else {
-            processed = processSequence(prepareYellowEdges(configuration, { incorrect1, incorrect2 }), "[YELLOW EDGES] Rotate the cube so that the " + incorrectEdges + " are on the Front and Right faces.");
+            processed = processSequence(prepareYellowEdges(configuration, { incorrect1, incorrect2 }), [=] { return "[YELLOW EDGES] Rotate the cube so that the " + incorrectEdges() + " are on the Front and Right faces."; });
             if (processed && userNum != SKIP) {
                 userNum = prompt(true);
                 if (userNum == EXIT) { return EXIT; }
             }
 
             algorithm = "URUR'URU2R'";
-            message = "[YELLOW EDGES] Perform an algorithm to swap the " + incorrectEdges + ".";
+            message = [=] { return "[YELLOW EDGES] Perform an algorithm to swap the " + incorrectEdges() + "."; };
         }
 
         processed = processSequence(algorithm, message);
@@ -973,7 +1035,7 @@ pair<string, vector<StickerData>> Assistant::matchYellowEdges() const {
     pair<string, vector<StickerData>> res;
     vector<StickerData> matchStickers;
     string sequence = "";
-    Cube temp = *cube;
+    CubeState temp = cube->getState();
 
     // Loop until 2 or more matches are found.
     int matches = 0;
@@ -1006,7 +1068,7 @@ pair<string, vector<StickerData>> Assistant::matchYellowEdges() const {
         }
 
         sequence += "U";
-        temp.doMoves("U", false);
+        temp.applyMove(FaceletMoves::getMove('U', 1));
     }
 
     res.first = simplifySequence(sequence);
@@ -1031,7 +1093,7 @@ string Assistant::prepareYellowEdges(const string& matchInfo, const pair<char, c
 
     // Check the coordinates' adjacent stickers for the original colors.
     string sequence = "";
-    Cube temp = *cube;
+    CubeState temp = cube->getState();
     while (true) {
         char edgeColor1 = temp.getAdjEdge(Cube::TOP, toCheck[0].first, toCheck[0].second).color;
         char edgeColor2 = temp.getAdjEdge(Cube::TOP, toCheck[1].first, toCheck[1].second).color;
@@ -1042,7 +1104,7 @@ string Assistant::prepareYellowEdges(const string& matchInfo, const pair<char, c
         }
 
         sequence += "y";
-        temp.doMoves("y", false);
+        temp.applyMove(FaceletMoves::getMove('y', 1));
     }
 
     return sequence;
@@ -1089,7 +1151,7 @@ int Assistant::getYellowCornersPosition() {
 
     // Get the yellow center facing up.
     int face = cube->findCenter('Y');
-    processed = processSequence(rotateToFace(face, Cube::TOP, false), "[YELLOW CORNERS POSITION] Rotate the cube so that the yellow center is on top.");
+    processed = processSequence(rotateToFace(face, Cube::TOP, false), [] { return "[YELLOW CORNERS POSITION] Rotate the cube so that the yellow center is on top."; });
     if (processed) {
         userNum = prompt(true);
         if (userNum == EXIT) { return EXIT; }
@@ -1123,9 +1185,9 @@ int Assistant::getYellowCornersPosition() {
         if (found) {
             StickerData sticker = { face, cube->getAt(face, row, col), row, col };
             pair<StickerData, StickerData> adjCorners = cube->getAdjCorners(face, row, col);
-            string cornerColors = Cube::getColors({ sticker.color, adjCorners.first.color, adjCorners.second.color }) + " corner";
+            auto cornerColors = [=] { return Cube::getColors({ sticker.color, adjCorners.first.color, adjCorners.second.color }) + " corner"; };
             
-            processed = processSequence(positionRightCorner({ sticker, adjCorners.first, adjCorners.second }), "[YELLOW CORNERS POSITION] Rotate the cube so that the " + cornerColors + " is on the Top, Front, and Right faces.");
+            processed = processSequence(positionRightCorner({ sticker, adjCorners.first, adjCorners.second }), [=] { return "[YELLOW CORNERS POSITION] Rotate the cube so that the " + cornerColors() + " is on the Top, Front, and Right faces."; });
             if (processed && userNum != SKIP) {
                 userNum = prompt(true);
                 if (userNum == EXIT) { return EXIT; }
@@ -1134,7 +1196,7 @@ int Assistant::getYellowCornersPosition() {
 
         // Apply the algorithm for this step.
         string algorithm = "URU'L'UR'U'L";
-        string message = "[YELLOW CORNERS POSITION] Perform an algorithm to swap all the yellow corners.";
+        function<string()> message = [] { return "[YELLOW CORNERS POSITION] Perform an algorithm to swap all the yellow corners."; };
 
         processed = processSequence(algorithm, message);
         if (processed && userNum != SKIP) {
@@ -1179,7 +1241,7 @@ int Assistant::getYellowCornersOrientation() {
 
     // Position the yellow face up.
     int face = cube->findCenter('Y');
-    processed = processSequence(rotateToFace(face, Cube::TOP, false), "[YELLOW CORNERS ORIENTATION] Rotate the cube so that the yellow center is on top.");
+    processed = processSequence(rotateToFace(face, Cube::TOP, false), [] { return "[YELLOW CORNERS ORIENTATION] Rotate the cube so that the yellow center is on top."; });
     if (processed) {
         userNum = prompt(true);
         if (userNum == EXIT) { return EXIT; }
@@ -1194,9 +1256,9 @@ int Assistant::getYellowCornersOrientation() {
 
     // Rotate to the first unsolved corner and position to the top, left, right face.
     pair<bool, pair<string, vector<char>>> corner = findNotOriented(false);
-    string cornerColors = Cube::getColors(corner.second.second) + " corner";
+    vector<char> cornerColors = corner.second.second;
 
-    processed = processSequence(corner.second.first, "[YELLOW CORNER ORIENTATION] Rotate the cube so that the " + cornerColors + " is on the Top, Right, and Front faces.");
+    processed = processSequence(corner.second.first, [=] { return "[YELLOW CORNER ORIENTATION] Rotate the cube so that the " + Cube::getColors(cornerColors) + " corner is on the Top, Right, and Front faces."; });
     if (processed && userNum != SKIP) {
         userNum = prompt(false);
         if (userNum == EXIT) { return EXIT; }
@@ -1206,7 +1268,7 @@ int Assistant::getYellowCornersOrientation() {
     string algorithm = correctOrientation();
 
     while (corner.first) {
-        processed = processSequence(algorithm, "[YELLOW CORNER ORIENTATION] Perform an algorithm to orient the " + cornerColors + " correctly.");
+        processed = processSequence(algorithm, [=] { return "[YELLOW CORNER ORIENTATION] Perform an algorithm to orient the " + Cube::getColors(cornerColors) + " corner correctly."; });
         if (processed && userNum != SKIP) {
             userNum = prompt(false);
             if (userNum == EXIT) { return EXIT; }
@@ -1214,9 +1276,9 @@ int Assistant::getYellowCornersOrientation() {
         
         // Turn to the next corner and calculate the algorithm for the next iteration.
         corner = findNotOriented(true);
-        cornerColors = Cube::getColors(corner.second.second) + " corner";
+        cornerColors = corner.second.second;
 
-        processed = processSequence(corner.second.first, "[YELLOW CORNER ORIENTATION] Turn the upper face so that the " + cornerColors + " is on the Top, Right, and Front faces.");
+        processed = processSequence(corner.second.first, [=] { return "[YELLOW CORNER ORIENTATION] Turn the upper face so that the " + Cube::getColors(cornerColors) + " corner is on the Top, Right, and Front faces."; });
         if (processed && userNum != SKIP) {
             userNum = prompt(false);
             if (userNum == EXIT) { return EXIT; }
@@ -1227,14 +1289,14 @@ int Assistant::getYellowCornersOrientation() {
 
     // Adjust the upper face, if necessary.
     string sequence = "";
-    Cube temp = *cube;
+    CubeState temp = cube->getState();
 
     while (temp.getAt(Cube::FRONT, 0, 0) != temp.getAt(Cube::FRONT, 1, 1)) { // Side of upper face needs to match face center color
         sequence += "U";
-        temp.doMoves("U", false);
+        temp.applyMove(FaceletMoves::getMove('U', 1));
     }
 
-    processed = processSequence(simplifySequence(sequence), "[YELLOW CORNER ORIENTATION] Turn the upper face to correctly align it.");
+    processed = processSequence(simplifySequence(sequence), [] { return "[YELLOW CORNER ORIENTATION] Turn the upper face to correctly align it."; });
     if (processed && userNum != SKIP) {
         userNum = prompt(false);
         if (userNum == EXIT) { return EXIT; }
@@ -1248,8 +1310,8 @@ pair<bool, pair<string, vector<char>>> Assistant::findNotOriented(bool useUMoves
     vector<char> colors = { '\0' };
     pair<bool, pair<string, vector<char>>> res = { false, make_pair("", colors) };
     string sequence = "";
-    string toAdd = useUMoves ? "U" : "y";
-    Cube temp = *cube;
+    char toAdd = useUMoves ? 'U' : 'y';
+    CubeState temp = cube->getState();
 
     // Locate the corner.
     int count = 3;
@@ -1262,7 +1324,7 @@ pair<bool, pair<string, vector<char>>> Assistant::findNotOriented(bool useUMoves
         }
 
         sequence += toAdd;
-        temp.doMoves(toAdd, false);
+        temp.applyMove(FaceletMoves::getMove(toAdd, 1));
     }
 
     // This means an unoriented corner had been found.
@@ -1279,13 +1341,14 @@ pair<bool, pair<string, vector<char>>> Assistant::findNotOriented(bool useUMoves
 }
 
 string Assistant::correctOrientation() const {
+    static const CompiledSequence ALGORITHM("R'D'RD");
     string sequence = "";
-    Cube temp = *cube;
+    CubeState temp = cube->getState();
 
     // The correct corner orientation is when yellow is facing up.
     while (temp.getAt(Cube::TOP, 2, 2) != 'Y') {
         sequence += "R'D'RD";
-        temp.doMoves("R'D'RD", false);
+        temp.applySequence(ALGORITHM);
     }
 
     return sequence;
@@ -3,10 +3,12 @@
 
 #include "cube.h"
 #include "sticker_data.h"
+#include "move_parser.h"
 #include <string>
 #include <vector>
 #include <map>
 #include <utility>
+#include <functional>
 using namespace std;
 
 class Assistant {
@@ -14,6 +16,21 @@ public:
 	enum Stages { WHITE_CROSS, WHITE_CORNERS, SECOND_LAYER, YELLOW_CROSS, YELLOW_EDGES, YELLOW_CORNERS_POSITION, YELLOW_CORNERS_ORIENTATION, SOLVED };
 	enum Instructions { EXIT, SKIP, CONT };
 
+	/**
+	 * A single step of a solve: the stage it belongs to, the moves to perform, and the instruction that goes with them.
+	 */
+	struct Step {
+		Stages stage;
+		vector<Move> moves;
+		function<string()> message; // Builds the instruction, which captures everything it needs by value
+
+		/**
+		 * Formats the step the way the interactive solve displays it, building the message only now.
+		 * @return The message followed by the moves.
+		 */
+		string format() const;
+	};
+
 	/**
 	 * Constructor for Assistant object.
 	 * @param cube The Cube to access.
@@ -24,7 +41,18 @@ public:
 	 * Solves the Cube, displaying steps for each stage.
 	 */
 	void solve();
+
+	/**
+	 * Solves a copy of the Cube without any input or output, leaving the Cube unchanged.
+	 * @return The steps that solve the Cube, in order (empty if it is already solved).
+	 */
+	vector<Step> createPlan();
 private:
+	/**
+	 * Runs every stage from the current one until the Cube is solved or the user exits.
+	 */
+	void solveStages();
+
 	/**
 	 * Prompts the user for instructions.
 	 * @param allowExiting Whether or not exiting should be allowed.
@@ -35,10 +63,10 @@ private:
 	/**
 	 * Processes a sequence and displays the result.
 	 * @param sequence The sequence to process.
-	 * @param message The message to output if there was a sequence performed.
+	 * @param message Builds the message to output if there was a sequence performed, which is stored in the step while planning.
 	 * @return Whether or not a sequence has been executed.
 	 */
-	bool processSequence(const string& sequence, const string& message);
+	bool processSequence(const string& sequence, const function<string()>& message);
 
 	/**
 	 * Simplfies clockwise sequences (triple moves -> prime, two moves have 2 appended).
@@ -315,6 +343,8 @@ private:
 	string correctOrientation() const;
 
 	Cube* cube;
+	vector<Step>* plan; // Where steps are recorded instead of displayed, if any
+	Stages stage;
 };
 
 #endif
\ No newline at end of file
@@ -2,6 +2,11 @@
 #include "tester.h"
 #include "assistant.h"
 #include "cube.h"
+#include "move_parser.h"
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <vector>
 using namespace std;
 
 int AssistantTests::runTests() const {
@@ -25,5 +30,69 @@ int AssistantTests::runTests() const {
         tester.test("When the cube is solved, it is treated like so", cube.checkSolved());
     }
 
+    // Test that a plan solves the cube in order without changing it
+    {
+        Cube cube;
+        string scramble = "RURFDLB'F2DLR'F2LB2xyz";
+        cube.doMoves(scramble, false);
+        Cube original = cube;
+        Assistant assistant(cube);
+        vector<Assistant::Step> plan = assistant.createPlan();
+        bool unchanged = cube == original && cube.getSnapshot() == original.getSnapshot();
+        bool ordered = true;
+
+        for (size_t i = 0; i < plan.size(); i++) {
+            ordered = ordered && !plan[i].moves.empty() && (i == 0 || plan[i - 1].stage <= plan[i].stage);
+            cube.doMoves(MoveParser::toString(plan[i].moves, false), false);
+        }
+
+        tester.test("A plan leaves the cube unchanged and its steps solve it in order", unchanged && ordered && cube.checkSolved());
+    }
+
+    // Test the plan of a solved cube
+    {
+        Cube cube;
+        Assistant assistant(cube);
+        tester.test("When the cube is solved, the plan is empty", assistant.createPlan().empty());
+    }
+
+    // Test the formatting of a step
+    {
+        Cube cube;
+        cube.doMoves("RURFDLB'F2DLR'F2LB2xyz", false);
+        Cube copy = cube;
+        Assistant planner(copy);
+        vector<Assistant::Step> plan = planner.createPlan();
+
+        // Step through the same solve, answering every prompt, and capture what is displayed.
+        istringstream input(string(1000, '\n'));
+        ostringstream output;
+        streambuf* oldIn = cin.rdbuf(input.rdbuf());
+        streambuf* oldOut = cout.rdbuf(output.rdbuf());
+        Assistant assistant(cube);
+        assistant.solve();
+        cin.rdbuf(oldIn);
+        cout.rdbuf(oldOut);
+
+        string displayed = output.str();
+        size_t position = 0;
+        bool matches = !plan.empty();
+        bool edge = false;
+        bool corner = false;
+
+        for (const Assistant::Step& step : plan) {
+            string formatted = step.format();
+            position = displayed.find("\n" + formatted + "\n", position);
+            matches = matches && position != string::npos;
+            if (position == string::npos) { break; }
+
+            position += formatted.length();
+            edge = edge || formatted.find(" edge ") != string::npos;
+            corner = corner || formatted.find(" corner ") != string::npos;
+        }
+
+        tester.test("A step is formatted as the interactive solve displays it, for both edge and corner steps", matches && edge && corner);
+    }
+
     return tester.finishTests();
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "batch_solver.h"
+#include "assistant.h"
+#include "cube.h"
+#include "file_handler.h"
+#include "move_parser.h"
+#include "record_reader.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+using namespace std;
+
+BatchSolver::BatchSolver(int numThreads) {
+    this->numThreads = max(numThreads, 1);
+    solved = 0;
+    failed = 0;
+}
+
+bool BatchSolver::solveFile(const string& inputFile, const string& outputFile) {
+    solved = 0;
+    failed = 0;
+
+    RecordReader reader(inputFile);
+    if (!reader.isOpen()) { return false; }
+
+    ofstream ofs(outputFile);
+    if (!ofs.is_open()) { return false; }
+
+    // Saves that have not been compacted yet are in the journal, whose newest records replace those of the file.
+    map<string, long long, less<>> journal = FileHandler::indexJournal(inputFile);
+    RecordReader journalReader(inputFile + FileHandler::JOURNAL_SUFFIX);
+    bool readingJournal = !journal.empty();
+
+    // Only one chunk of lines is held at a time, so files of any size are solved in constant memory.
+    vector<string> lines;
+    vector<string> results;
+    RecordView record;
+    bool reading = true;
+
+    while (reading || readingJournal) {
+        lines.clear();
+
+        while (reading && lines.size() < CHUNK_SIZE && (reading = reader.next(record))) {
+            if (!record.checkBlank() && journal.count(record.name) == 0) { // Skip blank lines and replaced records
+                lines.emplace_back(record.line);
+            }
+        }
+
+        // The journal's records follow those of the file.
+        while (!reading && readingJournal && lines.size() < CHUNK_SIZE && (readingJournal = journalReader.next(record))) {
+            if (FileHandler::checkNewest(journal, record)) {
+                lines.emplace_back(record.line);
+            }
+        }
+
+        solveChunk(lines, results);
+
+        for (const string& result : results) {
+            ofs << result << '\n';
+        }
+    }
+
+    return true;
+}
+
+int BatchSolver::getThreads() const { return numThreads; }
+
+long long BatchSolver::getSolved() const { return solved; }
+
+long long BatchSolver::getFailed() const { return failed; }
+
+void BatchSolver::solveChunk(const vector<string>& lines, vector<string>& results) {
+    results.assign(lines.size(), "");
+    atomic<size_t> next(0);
+    atomic<long long> invalid(0);
+    vector<thread> threads;
+
+    // Each thread takes the next unsolved record, so slow records do not hold up the others.
+    auto work = [&]() {
+        for (size_t i = next++; i < lines.size(); i = next++) {
+            if (!solveLine(lines[i], results[i])) {
+                invalid++;
+            }
+        }
+    };
+
+    int count = min((size_t) numThreads, lines.size());
+    for (int t = 1; t < count; t++) {
+        threads.emplace_back(work);
+    }
+
+    work();
+    for (thread& t : threads) {
+        t.join();
+    }
+
+    failed += invalid;
+    solved += lines.size() - invalid;
+}
+
+bool BatchSolver::solveLine(const string& line, string& result) const {
+    string name, scramble, moves, snapshot;
+    int totalMoves;
+
+    bool valid = handler.parseRecord(line, name, scramble, moves, totalMoves, snapshot)
+        && MoveParser::parse(scramble, nullptr) != -1 && MoveParser::parse(moves, nullptr) != -1;
+    if (!valid) {
+        result = name + ", , -1";
+        return false;
+    }
+
+    Cube cube(name, scramble, moves, totalMoves, snapshot);
+    Assistant assistant(cube);
+    vector<Move> solution;
+    int length = 0; // Counted like the total moves of a Cube, where double moves count twice
+
+    for (const Assistant::Step& step : assistant.createPlan()) {
+        solution.insert(solution.end(), step.moves.begin(), step.moves.end());
+    }
+
+    for (Move move : solution) {
+        length += move.getCount();
+    }
+
+    result = name + ", " + MoveParser::toString(solution, true) + ", " + to_string(length);
+    return true;
+}
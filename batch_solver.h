@@ -0,0 +1,73 @@
+#ifndef BATCH_SOLVER_H
+#define BATCH_SOLVER_H
+
+#include "file_handler.h"
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * Solves every cube of a file with the Assistant's beginner method, using a pool of threads.
+ * The file is read in chunks, so memory stays bounded no matter how many records it has, and
+ * each chunk's results are written (name, solution, and length) in the order of the input.
+ */
+class BatchSolver {
+public:
+    static const int CHUNK_SIZE = 4096; // The number of records read, solved, and written at a time
+
+    /**
+     * Constructor for BatchSolver.
+     * @param numThreads The number of threads that solve, at least 1.
+     */
+    BatchSolver(int numThreads);
+
+    /**
+     * Solves every record of a file and writes one line per record to another file.
+     * Records that cannot be read or contain invalid moves have an empty solution and a length of -1.
+     * Like a load, records saved to the journal replace those of the file with the same name and are solved after them.
+     * @param inputFile The name of the file of cubes, in the format used by FileHandler.
+     * @param outputFile The name of the file to write.
+     * @return Whether or not both files could be opened.
+     */
+    bool solveFile(const string& inputFile, const string& outputFile);
+
+    /**
+     * Gets the number of threads that solve.
+     * @return The number of threads.
+     */
+    int getThreads() const;
+
+    /**
+     * Gets the number of records solved by the last call to solveFile.
+     * @return The number of records solved.
+     */
+    long long getSolved() const;
+
+    /**
+     * Gets the number of records that could not be solved by the last call to solveFile.
+     * @return The number of invalid records.
+     */
+    long long getFailed() const;
+private:
+    /**
+     * Solves the records of a chunk in parallel.
+     * @param lines The records to solve.
+     * @param results The output lines, which will be updated in the same order.
+     */
+    void solveChunk(const vector<string>& lines, vector<string>& results);
+
+    /**
+     * Solves a single record.
+     * @param line The record to solve.
+     * @param result The output line without a newline, which will be updated.
+     * @return Whether or not the record was valid.
+     */
+    bool solveLine(const string& line, string& result) const;
+
+    FileHandler handler;
+    int numThreads;
+    long long solved;
+    long long failed;
+};
+
+#endif
@@ -0,0 +1,116 @@
+#include "batch_solver_tests.h"
+#include "tester.h"
+#include "batch_solver.h"
+#include "file_handler.h"
+#include "cube.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+using namespace std;
+
+namespace {
+    vector<string> readLines(const string& file) {
+        vector<string> lines;
+        ifstream ifs(file);
+        string line;
+
+        while (getline(ifs, line)) {
+            lines.push_back(line);
+        }
+
+        return lines;
+    }
+}
+
+int BatchSolverTests::runTests() const {
+    Tester tester;
+    const string OUTPUT_FILE = "test_files/batch_output.txt";
+    const string OUTPUT_FILE2 = "test_files/batch_output2.txt";
+
+    // Test that every record is solved in the order of the input
+    {
+        BatchSolver solver(4);
+        bool opened = solver.solveFile("test_files/valid_csv.txt", OUTPUT_FILE);
+        vector<string> input = readLines("test_files/valid_csv.txt");
+        vector<string> output = readLines(OUTPUT_FILE);
+        FileHandler handler;
+        bool passed = opened && input.size() == output.size() && solver.getSolved() == input.size() && solver.getFailed() == 0;
+
+        for (size_t i = 0; passed && i < input.size(); i++) {
+            string name, scramble, moves, snapshot, solution;
+            int totalMoves, length;
+            handler.parseRecord(input[i], name, scramble, moves, totalMoves, snapshot);
+            Cube cube(name, scramble, moves, totalMoves);
+
+            // Each output line is the name, the solution, and its length
+            size_t first = output[i].find(", ");
+            size_t second = output[i].rfind(", ");
+            string solvedName = output[i].substr(0, first);
+            solution = output[i].substr(first + 2, second - first - 2);
+            length = stoi(output[i].substr(second + 2));
+            cube.doMoves(solution, false);
+            passed = solvedName == name && Cube::countMoves(solution) == length && cube.checkSolved();
+        }
+
+        tester.test("Every record is solved and written in the order of the input", passed);
+    }
+
+    // Test that the number of threads does not change the output
+    {
+        BatchSolver solver(1);
+        solver.solveFile("test_files/valid_csv.txt", OUTPUT_FILE2);
+        tester.test("One thread writes the same output as several threads", readLines(OUTPUT_FILE) == readLines(OUTPUT_FILE2));
+    }
+
+    // Test records with invalid moves
+    {
+        BatchSolver solver(2);
+        bool opened = solver.solveFile("test_files/invalid_moves.txt", OUTPUT_FILE);
+        vector<string> output = readLines(OUTPUT_FILE);
+        bool passed = opened && output.size() == 1 && output[0] == "Clarence Mariano, , -1" && solver.getFailed() == 1;
+        tester.test("Records with invalid moves are written with a length of -1", passed);
+    }
+
+    // Test that saves still in the journal are solved
+    {
+        const string FILE_NAME = "test_files/batch_journal_test.txt";
+        ofstream(FILE_NAME) << "John, , R, 1\nDon, RURF, , 0\n";
+
+        FileHandler handler(FILE_NAME);
+        Cube john("John", "", "R", 1);
+        Cube bob("Bob", "F", "", 0);
+        john.doMoves("U", true);
+        bool saved = handler.saveCubeToFile(john) && handler.saveCubeToFile(bob);
+        ofstream(handler.getJournalName(), ios::app) << "Don, , U, 1"; // Cut off before its newline
+
+        BatchSolver solver(2);
+        bool opened = solver.solveFile(FILE_NAME, OUTPUT_FILE);
+        vector<string> output = readLines(OUTPUT_FILE);
+        vector<Cube> expected = { Cube("Don", "RURF", "", 0), john, bob };
+        bool passed = saved && opened && output.size() == expected.size() && solver.getSolved() == expected.size();
+
+        // The file's records come first, except John's, which the journal replaces
+        for (size_t i = 0; passed && i < expected.size(); i++) {
+            size_t first = output[i].find(", ");
+            size_t second = output[i].rfind(", ");
+            expected[i].doMoves(output[i].substr(first + 2, second - first - 2), false);
+            passed = output[i].substr(0, first) == expected[i].getName() && expected[i].checkSolved();
+        }
+
+        tester.test("Saves that were not compacted replace the file's records, and a cut off line is skipped", passed);
+
+        remove(FILE_NAME.c_str());
+        remove(handler.getJournalName().c_str());
+    }
+
+    // Test a file that cannot be opened
+    {
+        BatchSolver solver(2);
+        tester.test("A missing file cannot be solved", !solver.solveFile("test_files/missing.txt", OUTPUT_FILE));
+    }
+
+    remove(OUTPUT_FILE.c_str());
+    remove(OUTPUT_FILE2.c_str());
+    return tester.finishTests();
+}
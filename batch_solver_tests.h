@@ -0,0 +1,13 @@
+#ifndef BATCH_SOLVER_TESTS_H
+#define BATCH_SOLVER_TESTS_H
+
+class BatchSolverTests {
+public:
+    /**
+     * Runs BatchSolver tests.
+     * @return 0 if they passed, 1 if they did not.
+     */
+    int runTests() const;
+};
+
+#endif
@@ -0,0 +1,291 @@
+#include "binary_store.h"
+#include "cube.h"
+#include "move_parser.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+using namespace std;
+
+namespace {
+    const char FILE_MAGIC[8] = { 'R', 'C', 'A', 'S', 'T', 'O', '0', '1' };
+    const char COLORS[] = "WOGRBY"; // The color of each index of StoreRecord::stickers
+    const int NUM_FACELETS = 54;
+    const int NUM_LETTERS = 9;      // Nibbles below this are letters, and the rest are the modifiers of the letter before
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t recordSize;
+        uint32_t count;
+        uint64_t namesOffset;       // From the start of the file
+        uint64_t historiesOffset;   // From the start of the file
+        uint64_t fileSize;
+    };
+
+    /**
+     * Appends a sequence of moves as a varint of its number of nibbles followed by the nibbles, two per byte.
+     * @param moves The moves without spaces.
+     * @param res The string to append to.
+     * @return Whether or not the moves are valid.
+     */
+    bool encodeMoves(const string& moves, string& res) {
+        vector<Move> parsed;
+        if (MoveParser::parse(moves, &parsed) == -1) { return false; }
+
+        vector<unsigned char> nibbles;
+        for (const Move& move : parsed) {
+            nibbles.push_back(move.getLetterIndex());
+            if (move.getModifier() != Move::NONE) {
+                nibbles.push_back(NUM_LETTERS - 1 + move.getModifier());
+            }
+        }
+
+        uint64_t length = nibbles.size();
+        do {
+            res += (char) ((length & 0x7F) | (length >= 0x80 ? 0x80 : 0));
+            length >>= 7;
+        } while (length > 0);
+
+        for (size_t i = 0; i < nibbles.size(); i += 2) {
+            res += (char) (nibbles[i] | (i + 1 < nibbles.size() ? nibbles[i + 1] << 4 : 0));
+        }
+
+        return true;
+    }
+
+    /**
+     * Reads a sequence of moves written by encodeMoves.
+     * @param histories The move histories of the store.
+     * @param offset The offset of the sequence, which will be moved past it.
+     * @param moves The moves without spaces, which will be updated.
+     * @return Whether or not the sequence lies within the histories and only holds valid moves.
+     */
+    bool decodeMoves(string_view histories, uint64_t& offset, string& moves) {
+        uint64_t length = 0;
+        int shift = 0;
+        unsigned char byte;
+
+        do {
+            if (offset >= histories.size() || shift > 56) { return false; }
+            byte = histories[offset++];
+            length |= (uint64_t) (byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        if ((length + 1) / 2 > histories.size() - offset) { return false; }
+
+        vector<Move> decoded;
+        for (uint64_t i = 0; i < length; i++) {
+            int nibble = (histories[offset + i / 2] >> (i % 2 * 4)) & 0xF;
+
+            if (nibble < NUM_LETTERS) {
+                decoded.push_back(Move::create(nibble, Move::NONE));
+            } else if (!decoded.empty() && nibble < NUM_LETTERS + Move::PRIME_DOUBLE && decoded.back().getModifier() == Move::NONE) {
+                decoded.back() = Move::create(decoded.back().getLetterIndex(), nibble - NUM_LETTERS + 1);
+            } else {
+                return false;
+            }
+        }
+
+        offset += (length + 1) / 2;
+        moves = MoveParser::toString(decoded, false);
+        return true;
+    }
+}
+
+bool BinaryStore::Builder::add(const Cube& cube) {
+    StoreRecord record = {};
+    record.historyOffset = histories.size();
+    record.nameLength = cube.getName().size();
+    record.totalMoves = cube.getTotalMoves();
+
+    // The snapshot's checksum is kept so a damaged record falls back to replaying its moves, as in a CSV file.
+    string snapshot = cube.getSnapshot();
+    record.checksum = strtoul(snapshot.c_str() + NUM_FACELETS + 1, nullptr, 16);
+
+    for (int i = 0; i < NUM_FACELETS; i++) {
+        const char* color = strchr(COLORS, snapshot[i]);
+        if (color == nullptr || snapshot[i] == '\0') { return false; }
+
+        record.stickers[i / 2] |= (color - COLORS) << (i % 2 * 4);
+    }
+
+    string history;
+    if (!encodeMoves(cube.getScramble(), history) || !encodeMoves(cube.getMoves() + cube.getCurrentMoves(), history)) {
+        return false;
+    }
+
+    histories += history;
+    names.push_back(cube.getName());
+    records.push_back(record);
+    return true;
+}
+
+bool BinaryStore::Builder::write(const string& fileName) const {
+    // Sort the records by name, which lets find use a binary search, and lay the names out in the same order.
+    vector<int> order(records.size());
+    for (int i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+
+    sort(order.begin(), order.end(), [this](int a, int b) { return names[a] < names[b]; });
+
+    vector<StoreRecord> sorted;
+    string nameData;
+    for (int i : order) {
+        sorted.push_back(records[i]);
+        sorted.back().nameOffset = nameData.size();
+        nameData += names[i];
+    }
+
+    FileHeader header = {};
+    memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.recordSize = sizeof(StoreRecord);
+    header.count = sorted.size();
+    header.namesOffset = sizeof(FileHeader) + sorted.size() * sizeof(StoreRecord);
+    header.historiesOffset = header.namesOffset + nameData.size();
+    header.fileSize = header.historiesOffset + histories.size();
+
+    ofstream ofs(fileName, ios::binary);
+    if (!ofs.is_open()) { return false; }
+
+    ofs.write((const char*) &header, sizeof(header));
+    ofs.write((const char*) sorted.data(), sorted.size() * sizeof(StoreRecord));
+    ofs.write(nameData.data(), nameData.size());
+    ofs.write(histories.data(), histories.size());
+    ofs.close();
+    return !ofs.fail();
+}
+
+bool BinaryStore::checkFormat(const string& fileName) {
+    ifstream ifs(fileName, ios::binary);
+    char magic[sizeof(FILE_MAGIC)];
+
+    return ifs.read(magic, sizeof(magic)) && memcmp(magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0;
+}
+
+BinaryStore::BinaryStore() {
+    mapping = nullptr;
+    mappingSize = 0;
+    count = 0;
+    records = nullptr;
+}
+
+BinaryStore::~BinaryStore() {
+    unload();
+}
+
+bool BinaryStore::load(const string& fileName) {
+    unload();
+
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd == -1) { return false; }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t) sizeof(FileHeader)) {
+        close(fd);
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor is closed, even if the file is replaced by a compaction.
+    size_t size = info.st_size;
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) { return false; }
+
+    // Only the layout is checked here, and each record is checked when it is read, so loading takes constant time.
+    const FileHeader* header = (const FileHeader*) data;
+    if (memcmp(header->magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header->recordSize != sizeof(StoreRecord)
+    || header->fileSize != size || header->namesOffset != sizeof(FileHeader) + (uint64_t) header->count * sizeof(StoreRecord)
+    || header->historiesOffset < header->namesOffset || header->historiesOffset > size || header->count > INT32_MAX) {
+        munmap(data, size);
+        return false;
+    }
+
+    const char* bytes = (const char*) data;
+    mapping = data;
+    mappingSize = size;
+    count = header->count;
+    records = (const StoreRecord*) (bytes + sizeof(FileHeader));
+    names = string_view(bytes + header->namesOffset, header->historiesOffset - header->namesOffset);
+    histories = string_view(bytes + header->historiesOffset, size - header->historiesOffset);
+    return true;
+}
+
+void BinaryStore::unload() {
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+    }
+
+    mapping = nullptr;
+    mappingSize = 0;
+    count = 0;
+    records = nullptr;
+    names = string_view();
+    histories = string_view();
+}
+
+int BinaryStore::getCount() const { return count; }
+
+int BinaryStore::find(const string& name) const {
+    int low = 0;
+    int high = count - 1;
+
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        int comparison = getName(mid).compare(name);
+
+        if (comparison == 0) {
+            return mid;
+        } else if (comparison < 0) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+
+    return -1;
+}
+
+string_view BinaryStore::getName(int index) const {
+    const StoreRecord& record = records[index];
+    if (record.nameOffset > names.size() || record.nameLength > names.size() - record.nameOffset) {
+        return string_view();
+    }
+
+    return names.substr(record.nameOffset, record.nameLength);
+}
+
+int BinaryStore::getTotalMoves(int index) const { return records[index].totalMoves; }
+
+bool BinaryStore::readCube(int index, Cube& cube) const {
+    const StoreRecord& record = records[index];
+    uint64_t offset = record.historyOffset;
+    string scramble, moves;
+
+    if (!decodeMoves(histories, offset, scramble) || !decodeMoves(histories, offset, moves)) {
+        return false;
+    }
+
+    string snapshot(NUM_FACELETS, ' ');
+    for (int i = 0; i < NUM_FACELETS; i++) {
+        int color = (record.stickers[i / 2] >> (i % 2 * 4)) & 0xF;
+        snapshot[i] = (color < sizeof(COLORS) - 1) ? COLORS[color] : ' ';
+    }
+
+    char checksum[10];
+    snprintf(checksum, sizeof(checksum), "#%08x", record.checksum);
+    snapshot += checksum;
+
+    // The moves are only replayed if the stickers do not match their checksum.
+    cube = Cube(string(getName(index)), scramble, moves, record.totalMoves, snapshot);
+    return true;
+}
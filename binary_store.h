@@ -0,0 +1,131 @@
+#ifndef BINARY_STORE_H
+#define BINARY_STORE_H
+
+#include "cube.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+using namespace std;
+
+/**
+ * The fixed-size part of a saved Cube in a BinaryStore, which is followed in the file by the names and move histories.
+ */
+struct StoreRecord {
+    uint64_t nameOffset;        // From the start of the names
+    uint64_t historyOffset;     // From the start of the move histories, which hold the scramble and then the moves
+    uint32_t nameLength;
+    uint32_t totalMoves;
+    uint32_t checksum;          // The checksum of the stickers' snapshot (see CubeState)
+    unsigned char stickers[27]; // The color index of each facelet, two per byte
+    unsigned char reserved;
+};
+
+/**
+ * A read-only file of saved Cubes that is mapped into memory, so a Cube is found and built without parsing any text.
+ * The file holds a header, fixed-size records sorted by name, the names, and the move histories, which use
+ * 4 bits per letter or modifier after a varint of their length. Numbers are stored in the byte order of the machine.
+ */
+class BinaryStore {
+public:
+    /**
+     * Collects Cubes and writes them to a new store.
+     */
+    class Builder {
+    public:
+        /**
+         * Adds a Cube to the store.
+         * @param cube The Cube to add, whose name must not have been added before.
+         * @return Whether or not the Cube's moves and stickers could be encoded.
+         */
+        bool add(const Cube& cube);
+
+        /**
+         * Writes every added Cube, sorted by name, to a file.
+         * @param fileName The name of the file to write.
+         * @return Whether or not the file was written.
+         */
+        bool write(const string& fileName) const;
+    private:
+        vector<string> names;
+        vector<StoreRecord> records;
+        string histories;
+    };
+
+    /**
+     * Checks if a file starts with the header of a store, which tells it apart from a CSV file.
+     * @param fileName The name of the file.
+     * @return Whether or not the file is a store.
+     */
+    static bool checkFormat(const string& fileName);
+
+    /**
+     * Constructor for an empty BinaryStore.
+     */
+    BinaryStore();
+
+    /**
+     * Unmaps the file.
+     */
+    ~BinaryStore();
+
+    BinaryStore(const BinaryStore&) = delete;
+    BinaryStore& operator=(const BinaryStore&) = delete;
+
+    /**
+     * Maps a file written by a Builder into memory, replacing any file that was loaded before.
+     * @param fileName The name of the file to map.
+     * @return Whether or not the file exists and has the expected format.
+     */
+    bool load(const string& fileName);
+
+    /**
+     * Unmaps the file if one is loaded.
+     */
+    void unload();
+
+    /**
+     * Gets the number of Cubes in the store.
+     * @return The number of Cubes, 0 if no file is loaded.
+     */
+    int getCount() const;
+
+    /**
+     * Finds a Cube by name with a binary search of the records.
+     * @param name The name of the Cube.
+     * @return The index of the Cube, -1 if there is none with the name.
+     */
+    int find(const string& name) const;
+
+    /**
+     * Gets the name of a Cube.
+     * @param index The index of the Cube, where indices are in order of name.
+     * @return The name, empty if it lies outside of the file.
+     */
+    string_view getName(int index) const;
+
+    /**
+     * Gets the number of total moves of a Cube.
+     * @param index The index of the Cube.
+     * @return The number of total moves.
+     */
+    int getTotalMoves(int index) const;
+
+    /**
+     * Builds a Cube from its record.
+     * @param index The index of the Cube.
+     * @param cube The Cube, which will be updated.
+     * @return Whether or not the record could be decoded.
+     */
+    bool readCube(int index, Cube& cube) const;
+private:
+    void* mapping;
+    size_t mappingSize;
+    int count;
+    const StoreRecord* records;
+    string_view names;
+    string_view histories;
+};
+
+#endif
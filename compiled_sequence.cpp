@@ -0,0 +1,102 @@
+#include "compiled_sequence.h"
+#include "facelet_moves.h"
+#include "move_parser.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+using namespace std;
+
+namespace {
+    // Each thread keeps its own cache, so threads never wait on each other to look up a sequence.
+    thread_local map<string, CompiledSequence> cache;
+
+    /**
+     * Applies a move after a composed permutation, so each facelet is read through both permutations.
+     * @param composed The permutation to update.
+     * @param next The permutation of the move.
+     */
+    void compose(unsigned char* composed, const unsigned char* next) {
+        unsigned char res[FaceletMoves::NUM_FACELETS];
+        for (int i = 0; i < FaceletMoves::NUM_FACELETS; i++) {
+            res[i] = composed[next[i]];
+        }
+
+        copy(res, res + FaceletMoves::NUM_FACELETS, composed);
+    }
+}
+
+CompiledSequence::CompiledSequence() {
+    valid = true;
+    tokenized = "";
+    count = 0;
+    orientation = 0;
+
+    for (int i = 0; i < FaceletMoves::NUM_FACELETS; i++) {
+        permutation[i] = i;
+        turns[i] = i;
+        turnsInverse[i] = i;
+    }
+}
+
+CompiledSequence::CompiledSequence(const string& moves) : CompiledSequence() {
+    count = MoveParser::parse(moves, &this->moves);
+
+    if (count == -1) {
+        valid = false;
+        count = 0;
+        this->moves.clear();
+        return;
+    }
+
+    tokenized = MoveParser::toString(this->moves, true);
+
+    for (Move move : this->moves) {
+        compose(permutation, FaceletMoves::getPermutation(move.getIndex()));
+
+        // Rotations only change the orientation, which decides the faces that later turns are performed on.
+        if (move.getIndex() >= FaceletMoves::NUM_FACE_MOVES) {
+            orientation = FaceletMoves::rotate(orientation, move.getIndex());
+        } else {
+            compose(turns, FaceletMoves::getPermutation(FaceletMoves::getFrameMove(orientation, move.getIndex())));
+        }
+    }
+
+    for (int i = 0; i < FaceletMoves::NUM_FACELETS; i++) {
+        turnsInverse[turns[i]] = i;
+    }
+}
+
+const CompiledSequence* CompiledSequence::getCached(const string& moves) {
+    if (moves.length() > MAX_CACHED_LENGTH) {
+        return nullptr;
+    }
+
+    auto it = cache.find(moves);
+
+    if (it == cache.end()) {
+        if (cache.size() >= MAX_CACHED_SEQUENCES) {
+            return nullptr;
+        }
+
+        it = cache.emplace(moves, CompiledSequence(moves)).first;
+    }
+
+    return &it->second;
+}
+
+bool CompiledSequence::isValid() const { return valid; }
+
+const string& CompiledSequence::getTokenized() const { return tokenized; }
+
+const vector<Move>& CompiledSequence::getMoves() const { return moves; }
+
+int CompiledSequence::getCount() const { return count; }
+
+const unsigned char* CompiledSequence::getPermutation() const { return permutation; }
+
+const unsigned char* CompiledSequence::getTurns() const { return turns; }
+
+const unsigned char* CompiledSequence::getTurnsInverse() const { return turnsInverse; }
+
+int CompiledSequence::getOrientation() const { return orientation; }
@@ -0,0 +1,93 @@
+#ifndef COMPILED_SEQUENCE_H
+#define COMPILED_SEQUENCE_H
+
+#include "facelet_moves.h"
+#include "move_parser.h"
+#include <string>
+#include <vector>
+using namespace std;
+
+class CompiledSequence {
+public:
+    static const int MAX_CACHED_LENGTH = 64;
+    static const int MAX_CACHED_SEQUENCES = 4096;
+
+    /**
+     * Constructor for an empty CompiledSequence, which does nothing when applied.
+     */
+    CompiledSequence();
+
+    /**
+     * Constructor for CompiledSequence that composes every move of a sequence into one permutation.
+     * @param moves The sequence to compile.
+     */
+    CompiledSequence(const string& moves);
+
+    /**
+     * Gets a compiled sequence from the calling thread's cache, compiling it the first time the thread requests it.
+     * @param moves The sequence to get.
+     * @return A pointer to the cached sequence, which stays valid while the thread runs, or nullptr if the sequence is too
+     *         long or the cache is full.
+     */
+    static const CompiledSequence* getCached(const string& moves);
+
+    /**
+     * Checks if the compiled moves were valid.
+     * @return Whether or not the moves were valid.
+     */
+    bool isValid() const;
+
+    /**
+     * Gets the moves, each separated by spaces.
+     * @return The tokenized sequence.
+     */
+    const string& getTokenized() const;
+
+    /**
+     * Gets the individual moves of the sequence.
+     * @return The parsed moves.
+     */
+    const vector<Move>& getMoves() const;
+
+    /**
+     * Gets the number of moves in the sequence (double moves count twice).
+     * @return The number of moves.
+     */
+    int getCount() const;
+
+    /**
+     * Gets the permutation of the whole sequence, including its rotations.
+     * @return A pointer to 54 facelet indices, where facelet i receives the facelet at permutation[i].
+     */
+    const unsigned char* getPermutation() const;
+
+    /**
+     * Gets the face turns of the sequence without its rotations, as turns of the cube in its starting orientation.
+     * A cube that starts in another orientation performs them through its frame (see FaceletMoves::getFrame).
+     * @return A pointer to 54 facelet indices, where facelet i receives the facelet at turns[i].
+     */
+    const unsigned char* getTurns() const;
+
+    /**
+     * Gets the inverse of the face turns, which move the facelet at i to turnsInverse[i].
+     * @return A pointer to 54 facelet indices.
+     */
+    const unsigned char* getTurnsInverse() const;
+
+    /**
+     * Gets the orientation that the rotations of the sequence lead to from orientation 0.
+     * @return The index of the orientation (see FaceletMoves).
+     */
+    int getOrientation() const;
+private:
+    bool valid;
+    string tokenized;
+    vector<Move> moves;
+    int count;
+    unsigned char permutation[FaceletMoves::NUM_FACELETS];
+    unsigned char turns[FaceletMoves::NUM_FACELETS];
+    unsigned char turnsInverse[FaceletMoves::NUM_FACELETS];
+    int orientation;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "coordinates.h"
+using namespace std;
+
+namespace {
+    const int MAX_VALUES = 12;
+
+    /**
+     * Gets the value that has a given number of unused values below it.
+     * @param used Which values are already used.
+     * @param skip The number of unused values to skip.
+     * @return The value.
+     */
+    int findUnused(const bool* used, int skip) {
+        int value = 0;
+
+        for (; used[value] || skip > 0; value++) {
+            if (!used[value]) {
+                skip--;
+            }
+        }
+
+        return value;
+    }
+}
+
+int Coordinates::choose(int n, int k) {
+    if (k < 0 || k > n) { return 0; }
+
+    int res = 1;
+    for (int i = 0; i < k; i++) {
+        res = res * (n - i) / (i + 1);
+    }
+
+    return res;
+}
+
+int Coordinates::rankPermutation(const unsigned char* perm, int size) {
+    int res = 0;
+
+    for (int i = 0; i < size; i++) {
+        int smaller = 0;
+        for (int j = i + 1; j < size; j++) {
+            if (perm[j] < perm[i]) {
+                smaller++;
+            }
+        }
+
+        res = res * (size - i) + smaller;
+    }
+
+    return res;
+}
+
+void Coordinates::unrankPermutation(int rank, unsigned char* perm, int size, int offset) {
+    int digits[MAX_VALUES];
+    for (int i = size - 1; i >= 0; i--) {
+        digits[i] = rank % (size - i);
+        rank /= (size - i);
+    }
+
+    // Each digit counts the unused values that are smaller than its value.
+    bool used[MAX_VALUES] = {};
+    for (int i = 0; i < size; i++) {
+        int value = findUnused(used, digits[i]);
+        used[value] = true;
+        perm[i] = value + offset;
+    }
+}
+
+int Coordinates::rankSelection(const unsigned char* values, int size, int total) {
+    int res = 0;
+
+    for (int i = 0; i < size; i++) {
+        // Count the unused values that are smaller, so each digit has one fewer option than the last.
+        int smaller = values[i];
+        for (int j = 0; j < i; j++) {
+            if (values[j] < values[i]) {
+                smaller--;
+            }
+        }
+
+        res = res * (total - i) + smaller;
+    }
+
+    return res;
+}
+
+void Coordinates::unrankSelection(int rank, unsigned char* values, int size, int total) {
+    int digits[MAX_VALUES];
+    for (int i = size - 1; i >= 0; i--) {
+        digits[i] = rank % (total - i);
+        rank /= (total - i);
+    }
+
+    bool used[MAX_VALUES] = {};
+    for (int i = 0; i < size; i++) {
+        int value = findUnused(used, digits[i]);
+        used[value] = true;
+        values[i] = value;
+    }
+}
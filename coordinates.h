@@ -0,0 +1,55 @@
+#ifndef COORDINATES_H
+#define COORDINATES_H
+
+using namespace std;
+
+/**
+ * Converts arrangements of pieces to and from dense indices, which the solvers use to address their tables.
+ */
+class Coordinates {
+public:
+    /**
+     * Gets a binomial coefficient.
+     * @param n The number of elements.
+     * @param k The number of elements to choose.
+     * @return The number of combinations, 0 if k is greater than n.
+     */
+    static int choose(int n, int k);
+
+    /**
+     * Ranks a permutation by its Lehmer code, so the identity has a rank of 0.
+     * @param perm The permutation, whose values only need to be distinct.
+     * @param size The number of elements.
+     * @return The rank, from 0 to size! - 1.
+     */
+    static int rankPermutation(const unsigned char* perm, int size);
+
+    /**
+     * Creates the permutation with a given rank.
+     * @param rank The rank of the permutation.
+     * @param perm The permutation to fill.
+     * @param size The number of elements (at most 12).
+     * @param offset The smallest value of the permutation.
+     */
+    static void unrankPermutation(int rank, unsigned char* perm, int size, int offset);
+
+    /**
+     * Ranks an ordered selection of distinct values, such as the slots of a few pieces.
+     * @param values The selected values, each less than total.
+     * @param size The number of selected values.
+     * @param total The number of values to select from (at most 12).
+     * @return The rank, from 0 to total! / (total - size)! - 1.
+     */
+    static int rankSelection(const unsigned char* values, int size, int total);
+
+    /**
+     * Creates the ordered selection with a given rank.
+     * @param rank The rank of the selection.
+     * @param values The selection to fill.
+     * @param size The number of selected values.
+     * @param total The number of values to select from (at most 12).
+     */
+    static void unrankSelection(int rank, unsigned char* values, int size, int total);
+};
+
+#endif
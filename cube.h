@@ -1,18 +1,19 @@
 #ifndef CUBE_H
 #define CUBE_H
 
+#include "cube_state.h"
 #include "sticker_data.h"
+#include "compiled_sequence.h"
+#include "move_history.h"
 #include <string>
-#include <stack>
 #include <map>
 #include <set>
 #include <vector>
 #include <utility>
 using namespace std;
 
-class Cube {
+class Cube : public CubeState {
 public:
-    enum Faces { TOP, LEFT, FRONT, RIGHT, BACK, BOTTOM };
     static const set<char> VALID_MOVES;
     static const map<char, string> COLOR_STRINGS;
     static const map<int, string> FACE_STRINGS;
@@ -55,14 +56,6 @@ public:
 	 */
 	static string getFaces(const vector<int>& faces);
 
-	/**
-	 * Checks if a pair of colors are equal to another pair of colors.
-	 * @param colors1 One pair of colors.
-	 * @param colors2 Another pair of colors.
-	 * @return Whether or not the stickers match.
-	 */
-	static bool checkColors(const pair<char, char>& colors1, const pair<char, char>& colors2);
-
     /**
       * Checks whether the set of moves is valid (i.e. no unpaired numbers or apostrophes, only valid letters)
       * @param moves A set of moves.
@@ -99,84 +92,15 @@ public:
     Cube(const string& name, const string& scramble, const string& moves, int totalMoves);
 
     /**
-     * Gets the colors at a specified location.
-     * @param face The index of the face to check.
-     * @param row The row to check.
-     * @param col The column to check.
-     * @return A color at the location.
-     */
-    char getAt(int face, int row, int col) const;
-    
-    /**
-     * Locates a face that contains a specified center color.
-     * @param color The character representing the desired color.
-     * @return The index of the face containing the color.
-     */
-    int findCenter(char color) const;
-    
-	/**
-	 * Locates an edge based on two colors, returning its StickerData.
-	 * @param color1 The first color.
-	 * @param color2 The second color.
-	 * @return StickerData of the found edge.
-	 */
-	StickerData findEdge(char color1, char color2) const;
-
-    /**
-     * Gets the data of the adjacent edge of a given edge.
-     * @param face The index of the face of the given edge.
-     * @param row The row of the given edge.
-     * @param col The column of the given edge.
-     * @return StickerData containing the data of the adjacent edge.
-     */
-    StickerData getAdjEdge(int face, int row, int col) const;
-
-	/**
-	 * Checks if an edge has a certain color, and if its adjacent color matches their face's center color.
-	 * @param face The face of the edge.
-     * @param color The color that the edge must have.
-	 * @param coord A coordinate on the face, whose adjacent sticker needs to be checked.
-	 * @return True if the edge has the given color and if its adjacent color matches.
-	 */
-	bool checkEdgeMatch(int face, char color, const pair<int, int>& coord) const;
-
-	/**
-	 * Locates a corner with the given criteria.
-	 * @param baseColor The base color of the sticker.
-	 * @param adjColors The adjacent colors of the sticker.
-	 * @return A pair containing StickerData and a pair of StickerData, representing the base sticker and adjacent stickers respectively.
-	 */
-	pair<StickerData, pair<StickerData, StickerData>> findCorner(char baseColor, const pair<char, char>& adjColors) const;
-    
-    /**
-     * Gets the data of stickers adjacent to a given corner sticker.
-     * @param face The index of the face to check.
-     * @param row The row of the sticker.
-     * @param col The column of the sticker.
-     * @return A pair containing the data of two adjacent edges to a corner.
-     */
-    pair<StickerData, StickerData> getAdjCorners(int face, int row, int col) const;
-
-    /**
-     * Gets the two side-facing (not top or bottom) sides of a corner.
-     * @param corner A vector of StickerData of a corner.
-     * @return A pair of indices whose elements face to the sides.
-     */
-    pair<int, int> getSideCorners(const vector<StickerData>& corner) const;
-
-	/**
-	 * Checks if a corner is in its correct spot.
-	 * @param baseColor The base color.
-	 * @param colors The colors adjacent to the base color.
-	 * @return Whether or not the corner is in its correct spot.
-	 */
-	bool checkCornerPosition(char baseColor, const pair<char, char>& colors) const;
-
-    /**
-     * Checks if the Cube is solved (all faces contain one color).
-     * @return Whether or not the Cube is solved.
+     * Constructor for cube that restores its stickers from a snapshot instead of replaying its moves.
+     * If the snapshot is missing or damaged, the scramble and moves are replayed instead.
+     * @param name A unique name.
+     * @param scramble A string representing the original scramble of the Cube.
+     * @param moves A string of applied moves.
+     * @param totalMoves The total number of moves.
+     * @param snapshot A snapshot of the stickers (see CubeState::getSnapshot).
      */
-    bool checkSolved() const;
+    Cube(const string& name, const string& scramble, const string& moves, int totalMoves, const string& snapshot);
 
     /**
      * Gets the name of the Cube.
@@ -210,6 +134,7 @@ public:
 
     /**
      * Gets the current moves of the Cube.
+     * @return The current moves, converted once and cached as moves are added.
      */
     string getCurrentMoves() const;
 
@@ -219,6 +144,12 @@ public:
      */
     int getTotalMoves() const;
 
+    /**
+     * Gets the stickers of the Cube without its history or metadata, which is cheap to copy for look-ahead.
+     * @return The state of the Cube.
+     */
+    const CubeState& getState() const;
+
     /**
      * Displays the state of the Cube.
      * @param printCommands Whether or not commands should be displayed.
@@ -233,6 +164,13 @@ public:
      */
     string doMoves(const string& moves, bool update);
 
+    /**
+     * Performs a compiled sequence of moves on the cube in one step.
+     * @param sequence The compiled sequence.
+     * @param update Whether or not the moves should update the current moves and counter.
+     */
+    void doMoves(const CompiledSequence& sequence, bool update);
+
     /**
      * Undoes a move, returning the result of the undo.
      * @return A string that displays the result of the action.
@@ -244,6 +182,13 @@ public:
      */
     void reset();
 
+    /**
+     * Checks if replaying the scramble, moves, and current moves results in the stickers of the Cube,
+     * which verifies a Cube restored from a snapshot.
+     * @return Whether or not the history matches the stickers.
+     */
+    bool checkReplay() const;
+
     /**
      * Checks if Cubes are equal.
      * @param rhs The Cube to check against.
@@ -251,137 +196,6 @@ public:
      */
     bool operator==(const Cube& rhs) const;
 private:
-    static const map<int, char> FACE_COLORS;
-    static const int NUM_FACES = 6;
-    static const int SIZE = 3;
-
-    /**
-     * Sets the Cube to a solved state.
-     */
-    void createSolved();
-
-    /**
-     * Processes a valid move.
-     * @param letter A letter representing a valid move on the Rubik's cube.
-     */
-    void processMove(char letter);
-
-    /**
-     * Places colors on a specified face of the Cube.
-     * @param colors The colors to use.
-     * @param face The index of the face to give the colors to.
-     */
-    void placeFace(const vector<vector<char>>& colors, int face);
-
-    /**
-     * Places a given color segment in a given row of a face.
-     * @param colors The color to place into the face.
-     * @param face The index of the face to receive the new colors.
-     * @param row The row to place the colors in.
-     */
-    void placeRow(const vector<char>& colors, int face, int row);
-
-    /**
-     * Places a given color segment in a given column of a face.
-     * @param colors The color to place into the face.
-     * @param face The index of the face to receive the new colors.
-     * @param col The column to place the colors in.
-     */
-    void placeCol(const vector<char>& colors, int face, int col);
-
-    /**
-     * Gets a row of a face.
-     * @param face The index of the face to check.
-     * @param row The row of the face.
-     * @return The colors of a segment in a face.
-     */
-    vector<char> getRow(int face, int row) const;
-
-    /**
-     * Gets a column of a face.
-     * @param face The index of the face to check.
-     * @param col The column of the face.
-     * @return The colors of a segment in a face.
-     */
-    vector<char> getCol(int face, int col) const;
-
-    /**
-     * Rotates the colors of a given face in a clockwise fashion.
-     * @param face The index of the face to rotate.
-     */
-    void rotateFace(int face);
-
-    /**
-     * Performs a clockwise turn on the top side, rotating it.
-     * Switches the topmost rows of the left, front, right, and back faces.
-     */
-    void turnU();
-
-    /**
-     * Performs a clockwise turn on the left side, rotating it.
-     * Switches the columns of the top (leftmost), front (leftmost), bottom (leftmost), and back (rightmost) faces.
-     */
-    void turnL();
-
-    /**
-     * Performs a clockwise turn on the front side, rotating it.
-     * Switches the top row (bottom), right column (leftmost), bottom row (topmost), and left column (rightmost) faces.
-     */
-    void turnF();
-
-    /**
-     * Performs a clockwise turn on the right side, rotating it.
-     * Switches the columns of the top (rightmost), back (leftmost), bottom (rightmost), and front (rightmost) faces.
-     */
-    void turnR();
-
-    /**
-     * Performs a clockwise turn on the back side (looks counterclockwise from the front), rotating it.
-     * Switches the top row (topmost), left column (leftmost), bottom row (bottom), and right (rightmost) faces.
-     */
-    void turnB();
-
-    /**
-     * Performs a clockwise turn on the bottom side.
-     * Switching the bottom rows on left, front, right, and back faces.
-     */
-    void turnD();
-
-    /**
-     * Gets a face of the Cube.
-     * @param face The index of the face to get.
-     * @return The colors of a specified face.
-     */
-    vector<vector<char>> getFace(int face) const;
-
-    /**
-     * Gets a face of the Cube, read bottom-top, left-right to help with translation of faces during z rotations.
-     * @param face The index of the face to get.
-     * @return The colors of a specified face.
-     */
-    vector<vector<char>> getZFace(int face) const;
-
-    /**
-     * Rotates the Cube clockwise along the x-axis.
-     * Rotates the left face counterclockwise and the right face clockwise.
-     * Switches the middle faces in a clockwise fashion (front -> top, bottom -> front, back -> bottom, top -> back).
-     */
-    void rotX();
-
-    /**
-     * Rotates the Cube clockwise along the y-axis.
-     * Rotates the top face clockwise and the bottom face counterclockwise.
-     * Switches the middle faces in a clockwise fashion (front -> left, right -> front, back -> right, left -> back).
-     */
-    void rotY();
-
-    /**
-     * Rotates the Cube clockwise along the z-axis.
-     * Rotates the front face clockwise and the back face counterclockwise.
-     * Switches the middle faces in a clockwise fashion (top -> right, left -> top, bottom -> left, right -> bottom).
-     */
-    void rotZ();
-
     /**
      * Returns a colored representation of a face's segment.
      * @param side The face's side.
@@ -426,11 +240,10 @@ private:
      */
     string showMoves(const string& moves) const;
 
-    char stickers[NUM_FACES][SIZE][SIZE];
     string name;
     string scramble;
     string moves;
-    stack<string> currentMoves;
+    MoveHistory currentMoves;
     int totalMoves;
 };
 
@@ -0,0 +1,176 @@
+#include "cube_batch.h"
+#include "cube_state.h"
+#include "compiled_sequence.h"
+#include "facelet_moves.h"
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+namespace {
+    const int FACE_SIZE = 9;
+    const int NUM_FACES = 6;
+
+    /**
+     * Copies one row of facelets, which holds that facelet of every cube of a block.
+     * @param dest The row to write.
+     * @param src The row to read.
+     */
+    inline void copyRow(char* dest, const char* src) {
+#if defined(__AVX2__)
+        _mm256_store_si256((__m256i*) dest, _mm256_load_si256((const __m256i*) src));
+#elif defined(__SSE2__)
+        _mm_store_si128((__m128i*) dest, _mm_load_si128((const __m128i*) src));
+        _mm_store_si128((__m128i*) (dest + 16), _mm_load_si128((const __m128i*) (src + 16)));
+#else
+        memcpy(dest, src, CubeBatch::LANES);
+#endif
+    }
+}
+
+CubeBatch::CubeBatch(int size) {
+    count = max(size, 0);
+    blocks.resize((count + LANES - 1) / LANES);
+    scratch.resize(blocks.size());
+
+    // Every lane starts solved, including the unused lanes of the last block.
+    CubeState solved;
+    for (int i = 0; i < (int) blocks.size() * LANES; i++) {
+        setCube(i, solved);
+    }
+}
+
+int CubeBatch::size() const { return count; }
+
+void CubeBatch::setCube(int index, const CubeState& state) {
+    char facelets[FaceletMoves::NUM_FACELETS];
+    state.getFacelets(facelets);
+    Block& block = blocks[index / LANES];
+
+    for (int i = 0; i < FaceletMoves::NUM_FACELETS; i++) {
+        block.facelets[i][index % LANES] = facelets[i];
+    }
+}
+
+CubeState CubeBatch::getCube(int index) const {
+    char facelets[FaceletMoves::NUM_FACELETS];
+    const Block& block = blocks[index / LANES];
+
+    for (int i = 0; i < FaceletMoves::NUM_FACELETS; i++) {
+        facelets[i] = block.facelets[i][index % LANES];
+    }
+
+    CubeState res;
+    res.setFacelets(facelets);
+    return res;
+}
+
+void CubeBatch::applyMove(int move) {
+    permute(FaceletMoves::getPermutation(move));
+}
+
+void CubeBatch::applySequence(const CompiledSequence& sequence) {
+    if (sequence.isValid()) {
+        permute(sequence.getPermutation());
+    }
+}
+
+bool CubeBatch::applyMoves(const string& moves) {
+    const CompiledSequence* compiled = CompiledSequence::getCached(moves);
+    if (compiled != nullptr) {
+        applySequence(*compiled);
+        return compiled->isValid();
+    }
+
+    // Long sequences are still applied in one pass, but are not kept in the cache.
+    CompiledSequence sequence(moves);
+    applySequence(sequence);
+    return sequence.isValid();
+}
+
+bool CubeBatch::checkSolved(int index) const {
+    return (getSolvedMask(blocks[index / LANES]) >> (index % LANES)) & 1;
+}
+
+int CubeBatch::countSolved(int cubes) const {
+    cubes = (cubes == -1) ? count : min(max(cubes, 0), count);
+    int res = 0;
+
+    for (int i = 0; i * LANES < cubes; i++) {
+        uint32_t mask = getSolvedMask(blocks[i]);
+
+        // Only count the lanes of the last block that are checked.
+        int used = cubes - i * LANES;
+        if (used < LANES) {
+            mask &= (1u << used) - 1;
+        }
+
+        res += __builtin_popcount(mask);
+    }
+
+    return res;
+}
+
+void CubeBatch::permute(const unsigned char* permutation) {
+    for (size_t i = 0; i < blocks.size(); i++) {
+        for (int j = 0; j < FaceletMoves::NUM_FACELETS; j++) {
+            copyRow(scratch[i].facelets[j], blocks[i].facelets[permutation[j]]);
+        }
+    }
+
+    blocks.swap(scratch);
+}
+
+uint32_t CubeBatch::getSolvedMask(const Block& block) {
+#if defined(__AVX2__)
+    __m256i solved = _mm256_set1_epi8(-1);
+
+    // A face is solved in a lane if each of its facelets equals its first facelet.
+    for (int face = 0; face < NUM_FACES; face++) {
+        __m256i first = _mm256_load_si256((const __m256i*) block.facelets[face * FACE_SIZE]);
+        for (int i = 1; i < FACE_SIZE; i++) {
+            __m256i facelet = _mm256_load_si256((const __m256i*) block.facelets[face * FACE_SIZE + i]);
+            solved = _mm256_and_si256(solved, _mm256_cmpeq_epi8(facelet, first));
+        }
+    }
+
+    return (uint32_t) _mm256_movemask_epi8(solved);
+#elif defined(__SSE2__)
+    __m128i solved[2] = { _mm_set1_epi8(-1), _mm_set1_epi8(-1) };
+
+    for (int face = 0; face < NUM_FACES; face++) {
+        for (int half = 0; half < 2; half++) {
+            __m128i first = _mm_load_si128((const __m128i*) (block.facelets[face * FACE_SIZE] + half * 16));
+            for (int i = 1; i < FACE_SIZE; i++) {
+                __m128i facelet = _mm_load_si128((const __m128i*) (block.facelets[face * FACE_SIZE + i] + half * 16));
+                solved[half] = _mm_and_si128(solved[half], _mm_cmpeq_epi8(facelet, first));
+            }
+        }
+    }
+
+    return (uint32_t) _mm_movemask_epi8(solved[0]) | ((uint32_t) _mm_movemask_epi8(solved[1]) << 16);
+#else
+    uint32_t res = 0;
+
+    for (int lane = 0; lane < LANES; lane++) {
+        bool solved = true;
+        for (int face = 0; face < NUM_FACES && solved; face++) {
+            for (int i = 1; i < FACE_SIZE && solved; i++) {
+                solved = block.facelets[face * FACE_SIZE + i][lane] == block.facelets[face * FACE_SIZE][lane];
+            }
+        }
+
+        res |= (uint32_t) solved << lane;
+    }
+
+    return res;
+#endif
+}
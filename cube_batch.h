@@ -0,0 +1,106 @@
+#ifndef CUBE_BATCH_H
+#define CUBE_BATCH_H
+
+#include "cube_state.h"
+#include "compiled_sequence.h"
+#include "facelet_moves.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+using namespace std;
+
+/**
+ * Applies the same moves to many cubes at once. The cubes are stored in blocks, where each facelet is a row that holds
+ * that facelet of every cube of the block, one byte per cube. A move (or a whole compiled sequence) then moves each row
+ * to its new place with a single 256-bit copy, or two 128-bit copies without AVX2, however many moves it has.
+ * Moves use the same letters as Cube::VALID_MOVES, including rotations.
+ */
+class CubeBatch {
+public:
+    static const int LANES = 32; // The number of cubes in each block
+
+    /**
+     * Constructor for CubeBatch, whose cubes are all solved.
+     * @param size The number of cubes.
+     */
+    CubeBatch(int size);
+
+    /**
+     * Gets the number of cubes.
+     * @return The number of cubes.
+     */
+    int size() const;
+
+    /**
+     * Sets one cube to the stickers of a state, as they are seen.
+     * @param index The index of the cube.
+     * @param state The state to copy.
+     */
+    void setCube(int index, const CubeState& state);
+
+    /**
+     * Gets the stickers of one cube.
+     * @param index The index of the cube.
+     * @return A state with the cube's stickers.
+     */
+    CubeState getCube(int index) const;
+
+    /**
+     * Applies a move to every cube.
+     * @param move The index of the move (see FaceletMoves).
+     */
+    void applyMove(int move);
+
+    /**
+     * Applies a compiled sequence to every cube in one pass.
+     * @param sequence The sequence to apply, which is ignored if it is invalid.
+     */
+    void applySequence(const CompiledSequence& sequence);
+
+    /**
+     * Performs a sequence of moves on every cube.
+     * @param moves A set of moves.
+     * @return Whether or not the moves were valid (invalid moves are not applied).
+     */
+    bool applyMoves(const string& moves);
+
+    /**
+     * Checks if one cube is solved (all faces contain one color).
+     * @param index The index of the cube.
+     * @return Whether or not the cube is solved.
+     */
+    bool checkSolved(int index) const;
+
+    /**
+     * Counts the cubes that are solved, among the first cubes of the batch.
+     * @param cubes The number of cubes to check, -1 to check every cube.
+     * @return The number of solved cubes.
+     */
+    int countSolved(int cubes = -1) const;
+private:
+    /**
+     * The facelets of LANES cubes, where facelets[i][lane] is facelet i of the lane's cube.
+     */
+    struct Block {
+        alignas(LANES) char facelets[FaceletMoves::NUM_FACELETS][LANES];
+    };
+
+    /**
+     * Moves the facelets of every cube through a permutation.
+     * @param permutation The permutation, where facelet i receives the facelet at permutation[i].
+     */
+    void permute(const unsigned char* permutation);
+
+    /**
+     * Checks which cubes of a block are solved.
+     * @param block The block to check.
+     * @return A mask with bit i set if the cube in lane i is solved.
+     */
+    static uint32_t getSolvedMask(const Block& block);
+
+    vector<Block> blocks;
+    vector<Block> scratch; // Receives the permuted facelets, and is then swapped with the blocks
+    int count;
+};
+
+#endif
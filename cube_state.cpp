@@ -0,0 +1,486 @@
+#include "cube_state.h"
+#include "sticker_data.h"
+#include "cubie_cube.h"
+#include "facelet_moves.h"
+#include "compiled_sequence.h"
+#include "move_parser.h"
+#include "facelet_adjacency.h"
+#include "facelet_kernel.h"
+#include <cstring>
+#include <string>
+#include <map>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+using namespace std;
+
+namespace {
+	constexpr FaceletAdjacency ADJACENCY;
+	constexpr int EDGE_POSITIONS[] = { 1, 3, 5, 7 };   // Positions of the edges within a face (row * 3 + col)
+	constexpr int CORNER_POSITIONS[] = { 0, 2, 6, 8 }; // Positions of the corners within a face
+	constexpr char HOME_COLORS[] = "WOGRBY";         // The color of each face when solved, like FACE_COLORS
+
+	/**
+	 * Gets the face that a color belongs to when the cube is solved.
+	 * @param color The color of the face.
+	 * @return The index of the face, -1 if the color is not on any face.
+	 */
+	int getHomeFace(char color) {
+		for (int i = 0; i < 6; i++) {
+			if (HOME_COLORS[i] == color) {
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	/**
+	 * Computes the FNV-1a hash of the facelets of a snapshot.
+	 * @param facelets The facelets to hash.
+	 * @param length The number of facelets.
+	 * @return The checksum as 8 lowercase hexadecimal digits.
+	 */
+	string getChecksum(const char* facelets, int length) {
+		uint32_t hash = 2166136261u;
+		for (int i = 0; i < length; i++) {
+			hash = (hash ^ (unsigned char) facelets[i]) * 16777619u;
+		}
+
+		char digits[9];
+		snprintf(digits, sizeof(digits), "%08x", hash);
+		return digits;
+	}
+}
+
+const map<int, char> CubeState::FACE_COLORS = {
+	{ TOP, 'W' },
+	{ LEFT, 'O' },
+	{ FRONT, 'G' },
+	{ RIGHT, 'R' },
+	{ BACK, 'B' },
+	{ BOTTOM, 'Y' }
+};
+
+bool CubeState::checkColors(const pair<char, char>& colors1, const pair<char, char>& colors2) {
+    // Each color of the first pair is compared with both colors of the second pair, so a repeated color can match twice.
+    int numMatches = (colors1.first == colors2.first) + (colors1.first == colors2.second)
+        + (colors1.second == colors2.first) + (colors1.second == colors2.second);
+
+    return numMatches >= 2;
+}
+
+CubeState::CubeState() {
+	createSolved();
+}
+
+char CubeState::getAt(int face, int row, int col) const {
+	if ((face >= 0 && face < NUM_FACES)
+	&& (row >= 0 && row < SIZE)
+	&& (col >= 0 && col < SIZE)) {
+		return getFacelet(getIndex(face, row, col));
+	}
+
+	return '\0';
+}
+
+CubieCube CubeState::getCubieCube() const {
+	CubieCube res;
+	char facelets[NUM_FACES * SIZE * SIZE];
+	getFacelets(facelets);
+	res.setFacelets(facelets);
+	return res;
+}
+
+int CubeState::findCenter(char color) const {
+	// Face turns never move the centers, so the orientation alone decides which face each center is seen on.
+	if (centered) {
+		int face = getHomeFace(color);
+		return (face != -1) ? FaceletMoves::getFrameInverse(orientation)[getIndex(face, 1, 1)] / (SIZE * SIZE) : -1;
+	}
+
+	for (int i = 0; i < NUM_FACES; i++) {
+		if (getFacelet(getIndex(i, 1, 1)) == color) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+StickerData CubeState::findEdge(char color1, char color2) const {
+    StickerData res = { -1, '\0', -1, -1};
+
+    // Two different colors belong to at most one edge, so its location is looked up instead of searched for.
+    // Its sticker that comes first in the search order below is returned.
+    if (located && color1 != color2) {
+        int face1 = getHomeFace(color1);
+        int face2 = getHomeFace(color2);
+        int piece = (face1 != -1 && face2 != -1) ? ADJACENCY.pieces[(1 << face1) | (1 << face2)] : -1;
+        if (piece == -1) { return res; }
+
+        int facelet = FaceletMoves::getFrameInverse(orientation)[locations[piece]];
+        return getStickerData(min(facelet, (int) ADJACENCY.edges[facelet]));
+    }
+
+    // Check each face and each edge, in order of row and then column.
+    for (int i = 0; i < NUM_FACES; i++) {
+        for (int pos : EDGE_POSITIONS) {
+            int facelet = i * SIZE * SIZE + pos;
+            char edge = getFacelet(facelet);
+            char adjEdge = getFacelet(ADJACENCY.edges[facelet]);
+            
+            if (checkColors({ edge, adjEdge }, { color1, color2 })) {
+                return getStickerData(facelet);
+            }
+        }
+    }
+
+    return res;
+}
+
+StickerData CubeState::getAdjEdge(int face, int row, int col) const {
+    if (face < 0 || face >= NUM_FACES) {
+        return { -1, '\0', -1, -1 };
+    }
+
+    // Coordinates outside of the face get the same sticker as the face's bottom edge, like its corners and center.
+    bool inFace = row >= 0 && row < SIZE && col >= 0 && col < SIZE;
+    return getStickerData(ADJACENCY.edges[inFace ? getIndex(face, row, col) : getIndex(face, 2, 1)]);
+}
+
+bool CubeState::checkEdgeMatch(int face, char color, const pair<int, int>& coord) const {
+	StickerData adjEdge = getAdjEdge(face, coord.first, coord.second);
+
+	// Check if an actual adjacent edge was found, then proceed with verifiying the match.
+	if (adjEdge.row == -1) { return false; }
+    char centerColor = getFacelet(getIndex(adjEdge.face, 1, 1));
+
+    // The top of the edge must be the given color, and the adjacent edge's color
+    // must match its faces center color.
+    if (getFacelet(getIndex(face, coord.first, coord.second)) == color
+    && adjEdge.color == centerColor) {
+        return true;
+    }
+
+    return false;
+}
+
+pair<StickerData, pair<StickerData, StickerData>> CubeState::findCorner(char baseColor, const pair<char, char>& adjColors) const {
+    pair<StickerData, pair<StickerData, StickerData>> res = {
+		{-1, '\0', -1, -1},
+		{ {-1, '\0', -1, -1 }, { -1, '\0', -1, -1 } }
+	};
+
+    // Three different colors belong to at most one corner, whose stickers keep their clockwise order as it moves,
+    // so the base sticker is found from where the corner's first sticker is.
+    if (located && adjColors.first != adjColors.second) {
+        int baseFace = getHomeFace(baseColor);
+        int face1 = getHomeFace(adjColors.first);
+        int face2 = getHomeFace(adjColors.second);
+        int piece = -1;
+
+        if (baseFace != -1 && face1 != -1 && face2 != -1 && baseFace != face1 && baseFace != face2) {
+            piece = ADJACENCY.pieces[(1 << baseFace) | (1 << face1) | (1 << face2)];
+        }
+
+        if (piece == -1) { return res; }
+
+        int sticker = 0;
+        while (FaceletAdjacency::CORNER_FACELETS[piece][sticker] / (SIZE * SIZE) != baseFace) {
+            sticker++;
+        }
+
+        int location = locations[CubieCube::NUM_EDGES + piece];
+        int facelet = FaceletAdjacency::CORNER_FACELETS[ADJACENCY.slots[location]][(ADJACENCY.orientations[location] + sticker) % 3];
+        facelet = FaceletMoves::getFrameInverse(orientation)[facelet];
+        const unsigned char* adjFacelets = ADJACENCY.corners[facelet];
+
+        res.first = getStickerData(facelet);
+        res.second = { getStickerData(adjFacelets[0]), getStickerData(adjFacelets[1]) };
+        return res;
+    }
+
+    // Check each face and its corners, in order of row and then column.
+    for (int i = 0; i < NUM_FACES; i++) {
+        for (int pos : CORNER_POSITIONS) {
+            int facelet = i * SIZE * SIZE + pos;
+            const unsigned char* adjFacelets = ADJACENCY.corners[facelet];
+
+            if (getFacelet(facelet) == baseColor && checkColors(adjColors, { getFacelet(adjFacelets[0]), getFacelet(adjFacelets[1]) })) {
+                res.first = getStickerData(facelet);
+				res.second = { getStickerData(adjFacelets[0]), getStickerData(adjFacelets[1]) };
+                return res;
+            }
+        }
+    }
+
+    return res;
+}
+
+pair<StickerData, StickerData> CubeState::getAdjCorners(int face, int row, int col) const {
+    if (face < 0 || face >= NUM_FACES) {
+        return { { -1, '\0', -1, -1 }, { -1, '\0', -1, -1 } };
+    }
+
+    // Coordinates outside of the face get the same stickers as the face's bottom right corner, like its edges and center.
+    bool inFace = row >= 0 && row < SIZE && col >= 0 && col < SIZE;
+    const unsigned char* adjFacelets = ADJACENCY.corners[inFace ? getIndex(face, row, col) : getIndex(face, 2, 2)];
+    return { getStickerData(adjFacelets[0]), getStickerData(adjFacelets[1]) };
+}
+
+StickerData CubeState::getStickerData(int facelet) const {
+    return { facelet / (SIZE * SIZE), getFacelet(facelet), facelet % (SIZE * SIZE) / SIZE, facelet % SIZE };
+}
+
+char CubeState::getFacelet(int facelet) const {
+    return stickers[FaceletMoves::getFrame(orientation)[facelet]];
+}
+
+void CubeState::getFacelets(char* facelets) const {
+    const unsigned char* frame = FaceletMoves::getFrame(orientation);
+    for (int i = 0; i < NUM_FACES * SIZE * SIZE; i++) {
+        facelets[i] = stickers[frame[i]];
+    }
+}
+
+void CubeState::setFacelets(const char* facelets) {
+    // Find the orientation that sees every center on its own face, or keep the facelets as they are if there is none.
+    orientation = 0;
+    centered = false;
+
+    for (int i = 0; i < FaceletMoves::NUM_ORIENTATIONS && !centered; i++) {
+        const unsigned char* inverse = FaceletMoves::getFrameInverse(i);
+        centered = true;
+
+        for (int face = 0; face < NUM_FACES && centered; face++) {
+            centered = facelets[inverse[getIndex(face, 1, 1)]] == HOME_COLORS[face];
+        }
+
+        orientation = centered ? i : 0;
+    }
+
+    const unsigned char* inverse = FaceletMoves::getFrameInverse(orientation);
+    for (int i = 0; i < NUM_FACES * SIZE * SIZE; i++) {
+        stickers[i] = facelets[inverse[i]];
+    }
+
+    locatePieces();
+}
+
+pair<int, int> CubeState::getSideCorners(const vector<StickerData>& corner) const {
+	pair<int, int> indices = { -1, -1 };
+
+	for (int i = 0; i < corner.size(); i++) {
+        if (corner[i].face == TOP || corner[i].face == BOTTOM) {
+			// Once an non-side-facing index is found, the other indices are guaranteed to be side-facing,
+			// unless there is invalid data being input.
+			int testIdx1 = (i + 1) % corner.size();
+			int testIdx2 = (i + 2) % corner.size();
+
+			if (corner[testIdx1].face == TOP || corner[testIdx1].face == BOTTOM
+			|| corner[testIdx2].face == TOP || corner[testIdx2].face == BOTTOM) {
+				return indices;
+			} else {
+				indices.first = (i + 1) % corner.size();
+				indices.second = (i + 2) % corner.size();
+				return indices;
+			}
+        }
+    }
+
+	return indices;
+}
+
+bool CubeState::checkCornerPosition(char baseColor, const pair<char, char>& colors) const {
+    // Check if the corner is in the correct spot.
+    // First, get the corner colors of the given row and column.
+    // Then, check the side-facing stickers and see if their faces contain the center colors of the correct faces.
+    pair<StickerData, pair<StickerData, StickerData>> corner = findCorner(baseColor, colors);
+    vector<StickerData> cornerStickers = { corner.first, corner.second.first, corner.second.second };
+    bool foundBase = false; 
+    int side1Idx, side2Idx;
+
+	if (corner.first.row == -1) { return false; }
+
+    // Determine if the base color is found, since different corners can have the same adjacent colors.
+    for (int i = 0; i < cornerStickers.size(); i++) {
+        if (cornerStickers[i].color == baseColor) {
+            foundBase = true;
+        }
+    }
+
+    // Proceed with checking the side-facing stickers if the base color was found.
+    if (foundBase) {
+		pair<int, int> indices = getSideCorners(cornerStickers);
+        char side1Center = getFacelet(getIndex(cornerStickers[indices.first].face, 1, 1));
+        char side2Center = getFacelet(getIndex(cornerStickers[indices.second].face, 1, 1));
+		
+        if (checkColors(colors, { side1Center, side2Center })) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool CubeState::checkSolved() const {
+	// The orientation only changes which face each face of the stickers is seen as, so the stickers are checked directly.
+	for (int i = 0; i < NUM_FACES; i++) {
+		char colorToMatch = stickers[getIndex(i, 0, 0)];
+
+		for (int j = 0; j < SIZE; j++) {
+			for (int k = 0; k < SIZE; k++) {
+				if (stickers[getIndex(i, j, k)] != colorToMatch) {
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+string CubeState::getSnapshot() const {
+	const int NUM_FACELETS = NUM_FACES * SIZE * SIZE;
+	char facelets[NUM_FACELETS];
+	getFacelets(facelets);
+	return string(facelets, NUM_FACELETS) + "#" + getChecksum(facelets, NUM_FACELETS);
+}
+
+bool CubeState::setSnapshot(const string& snapshot) {
+	const int NUM_FACELETS = NUM_FACES * SIZE * SIZE;
+	if (snapshot.length() != SNAPSHOT_LENGTH || snapshot[NUM_FACELETS] != '#'
+	|| snapshot.compare(NUM_FACELETS + 1, string::npos, getChecksum(snapshot.data(), NUM_FACELETS)) != 0) {
+		return false;
+	}
+
+	setFacelets(snapshot.data());
+	return true;
+}
+
+void CubeState::applyMove(int move) {
+	if (move >= FaceletMoves::NUM_FACE_MOVES) {
+		orientation = FaceletMoves::rotate(orientation, move);
+		return;
+	}
+
+	int turn = FaceletMoves::getFrameMove(orientation, move);
+	FaceletKernel::permute(stickers, FaceletMoves::getPackedPermutation(turn));
+
+	// A sticker moves to the facelet that the inverse move takes it from.
+	FaceletKernel::lookup(locations, FaceletMoves::getPackedPermutation(FaceletMoves::getInverse(turn)));
+}
+
+void CubeState::applySequence(const CompiledSequence& sequence) {
+	// The turns are seen from the sequence's starting orientation, so they are read through the frame of the cube's orientation.
+	const int NUM_FACELETS = NUM_FACES * SIZE * SIZE;
+	const unsigned char* frame = FaceletMoves::getFrame(orientation);
+	const unsigned char* frameInverse = FaceletMoves::getFrameInverse(orientation);
+	const unsigned char* turns = sequence.getTurns();
+	const unsigned char* turnsInverse = sequence.getTurnsInverse();
+	alignas(FaceletKernel::PACKED_SIZE) unsigned char permutation[FaceletKernel::PACKED_SIZE];
+	alignas(FaceletKernel::PACKED_SIZE) unsigned char inverse[FaceletKernel::PACKED_SIZE];
+
+	for (int i = 0; i < FaceletKernel::PACKED_SIZE; i++) {
+		permutation[i] = (i < NUM_FACELETS) ? frame[turns[frameInverse[i]]] : i;
+		inverse[i] = (i < NUM_FACELETS) ? frame[turnsInverse[frameInverse[i]]] : i;
+	}
+
+	FaceletKernel::permute(stickers, permutation);
+	FaceletKernel::lookup(locations, inverse);
+	orientation = FaceletMoves::combine(orientation, sequence.getOrientation());
+}
+
+bool CubeState::applyMoves(const string& moves) {
+	const CompiledSequence* compiled = CompiledSequence::getCached(moves);
+	if (compiled != nullptr) {
+		if (compiled->isValid()) {
+			applySequence(*compiled);
+		}
+
+		return compiled->isValid();
+	}
+
+	vector<Move> parsed;
+	if (MoveParser::parse(moves, &parsed) == -1) {
+		return false;
+	}
+
+	for (Move move : parsed) {
+		applyMove(move.getIndex());
+	}
+
+	return true;
+}
+
+int CubeState::getIndex(int face, int row, int col) { return face * SIZE * SIZE + row * SIZE + col; }
+
+void CubeState::createSolved() {
+	// The padding after the stickers and locations is cleared, so that it always indexes inside a packed block.
+	memset(stickers, 0, sizeof(stickers));
+	memset(locations, 0, sizeof(locations));
+
+	for (int i = 0; i < NUM_FACES; i++) { // For each face, fill its facelets with its color
+		memset(stickers + getIndex(i, 0, 0), FACE_COLORS.at(i), SIZE * SIZE);
+	}
+
+	orientation = 0;
+	centered = true;
+
+	// Every piece starts in its own slot, with its first sticker on the slot's first facelet.
+	for (int i = 0; i < CubieCube::NUM_EDGES; i++) {
+		locations[i] = FaceletAdjacency::EDGE_FACELETS[i][0];
+	}
+
+	for (int i = 0; i < CubieCube::NUM_CORNERS; i++) {
+		locations[CubieCube::NUM_EDGES + i] = FaceletAdjacency::CORNER_FACELETS[i][0];
+	}
+
+	located = true;
+}
+
+void CubeState::locatePieces() {
+	bool foundEdges[CubieCube::NUM_EDGES] = {};
+	bool foundCorners[CubieCube::NUM_CORNERS] = {};
+	located = false;
+
+	// Each slot must hold a different piece, which is identified by the faces its colors belong to.
+	for (int i = 0; i < CubieCube::NUM_EDGES; i++) {
+		const unsigned char* slot = FaceletAdjacency::EDGE_FACELETS[i];
+		int faces[2] = { getHomeFace(stickers[slot[0]]), getHomeFace(stickers[slot[1]]) };
+
+		if (faces[0] == -1 || faces[1] == -1 || faces[0] == faces[1]) { return; }
+		int piece = ADJACENCY.pieces[(1 << faces[0]) | (1 << faces[1])];
+		if (piece == -1 || foundEdges[piece]) { return; }
+
+		foundEdges[piece] = true;
+		locations[piece] = (faces[0] == FaceletAdjacency::EDGE_FACELETS[piece][0] / (SIZE * SIZE)) ? slot[0] : slot[1];
+	}
+
+	for (int i = 0; i < CubieCube::NUM_CORNERS; i++) {
+		const unsigned char* slot = FaceletAdjacency::CORNER_FACELETS[i];
+		int faces[3] = { getHomeFace(stickers[slot[0]]), getHomeFace(stickers[slot[1]]), getHomeFace(stickers[slot[2]]) };
+
+		if (faces[0] == -1 || faces[1] == -1 || faces[2] == -1
+		|| faces[0] == faces[1] || faces[0] == faces[2] || faces[1] == faces[2]) { return; }
+		int piece = ADJACENCY.pieces[(1 << faces[0]) | (1 << faces[1]) | (1 << faces[2])];
+		if (piece == -1 || foundCorners[piece]) { return; }
+
+		// A corner whose colors are in the wrong order could only be there if it was taken apart.
+		const unsigned char* home = FaceletAdjacency::CORNER_FACELETS[piece];
+		int first = 0;
+		while (faces[first] != home[0] / (SIZE * SIZE)) {
+			first++;
+		}
+
+		if (faces[(first + 1) % 3] != home[1] / (SIZE * SIZE)) { return; }
+
+		foundCorners[piece] = true;
+		locations[CubieCube::NUM_EDGES + piece] = slot[first];
+	}
+
+	located = true;
+}
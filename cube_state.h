@@ -0,0 +1,223 @@
+#ifndef CUBE_STATE_H
+#define CUBE_STATE_H
+
+#include "sticker_data.h"
+#include "cubie_cube.h"
+#include "compiled_sequence.h"
+#include "facelet_kernel.h"
+#include "facelet_moves.h"
+#include <string>
+#include <map>
+#include <vector>
+#include <utility>
+#include <type_traits>
+using namespace std;
+
+/**
+ * The stickers of a cube without any history or metadata, so copies are a single fixed-size block.
+ * Every move also updates where each edge and corner piece is, so they can be found without searching the stickers.
+ * Whole-cube rotations only change the orientation that the stickers are seen from, and face turns are performed
+ * on the faces seen from it, so rotating never moves any stickers.
+ */
+class CubeState {
+public:
+    enum Faces { TOP, LEFT, FRONT, RIGHT, BACK, BOTTOM };
+    static const int SNAPSHOT_LENGTH = 63; // 54 facelets, a '#', and an 8-digit hexadecimal checksum
+
+	/**
+	 * Checks if a pair of colors are equal to another pair of colors.
+	 * @param colors1 One pair of colors.
+	 * @param colors2 Another pair of colors.
+	 * @return Whether or not the stickers match.
+	 */
+	static bool checkColors(const pair<char, char>& colors1, const pair<char, char>& colors2);
+
+    /**
+     * Constructor for CubeState, which is solved.
+     */
+    CubeState();
+
+    /**
+     * Gets the colors at a specified location.
+     * @param face The index of the face to check.
+     * @param row The row to check.
+     * @param col The column to check.
+     * @return A color at the location.
+     */
+    char getAt(int face, int row, int col) const;
+
+    /**
+     * Gets the corner and edge pieces of the Cube, identified relative to its centers.
+     * @return A CubieCube representing the stickers.
+     */
+    CubieCube getCubieCube() const;
+    
+    /**
+     * Locates a face that contains a specified center color.
+     * @param color The character representing the desired color.
+     * @return The index of the face containing the color.
+     */
+    int findCenter(char color) const;
+    
+	/**
+	 * Locates an edge based on two colors, returning its StickerData.
+	 * @param color1 The first color.
+	 * @param color2 The second color.
+	 * @return StickerData of the found edge.
+	 */
+	StickerData findEdge(char color1, char color2) const;
+
+    /**
+     * Gets the data of the adjacent edge of a given edge.
+     * @param face The index of the face of the given edge.
+     * @param row The row of the given edge.
+     * @param col The column of the given edge.
+     * @return StickerData containing the data of the adjacent edge.
+     */
+    StickerData getAdjEdge(int face, int row, int col) const;
+
+	/**
+	 * Checks if an edge has a certain color, and if its adjacent color matches their face's center color.
+	 * @param face The face of the edge.
+     * @param color The color that the edge must have.
+	 * @param coord A coordinate on the face, whose adjacent sticker needs to be checked.
+	 * @return True if the edge has the given color and if its adjacent color matches.
+	 */
+	bool checkEdgeMatch(int face, char color, const pair<int, int>& coord) const;
+
+	/**
+	 * Locates a corner with the given criteria.
+	 * @param baseColor The base color of the sticker.
+	 * @param adjColors The adjacent colors of the sticker.
+	 * @return A pair containing StickerData and a pair of StickerData, representing the base sticker and adjacent stickers respectively.
+	 */
+	pair<StickerData, pair<StickerData, StickerData>> findCorner(char baseColor, const pair<char, char>& adjColors) const;
+    
+    /**
+     * Gets the data of stickers adjacent to a given corner sticker.
+     * @param face The index of the face to check.
+     * @param row The row of the sticker.
+     * @param col The column of the sticker.
+     * @return A pair containing the data of two adjacent edges to a corner.
+     */
+    pair<StickerData, StickerData> getAdjCorners(int face, int row, int col) const;
+
+    /**
+     * Gets the two side-facing (not top or bottom) sides of a corner.
+     * @param corner A vector of StickerData of a corner.
+     * @return A pair of indices whose elements face to the sides.
+     */
+    pair<int, int> getSideCorners(const vector<StickerData>& corner) const;
+
+	/**
+	 * Checks if a corner is in its correct spot.
+	 * @param baseColor The base color.
+	 * @param colors The colors adjacent to the base color.
+	 * @return Whether or not the corner is in its correct spot.
+	 */
+	bool checkCornerPosition(char baseColor, const pair<char, char>& colors) const;
+
+    /**
+     * Checks if the Cube is solved (all faces contain one color).
+     * @return Whether or not the Cube is solved.
+     */
+    bool checkSolved() const;
+
+    /**
+     * Encodes the stickers as text that can be stored and restored without replaying any moves.
+     * @return The 54 facelet colors followed by '#' and their checksum.
+     */
+    string getSnapshot() const;
+
+    /**
+     * Restores the stickers from a snapshot, if its checksum matches its facelets.
+     * @param snapshot A string created by getSnapshot.
+     * @return Whether or not the snapshot was intact (the stickers are unchanged if it was not).
+     */
+    bool setSnapshot(const string& snapshot);
+
+    /**
+     * Writes every facelet as seen from the cube's orientation.
+     * @param facelets The 54 facelets to write to.
+     */
+    void getFacelets(char* facelets) const;
+
+    /**
+     * Sets every facelet as it is seen, turning the stored stickers so that each center is on its own face.
+     * @param facelets The 54 facelets to read.
+     */
+    void setFacelets(const char* facelets);
+
+    /**
+     * Applies a move through its precomputed facelet permutation.
+     * @param move The index of the move (see FaceletMoves).
+     */
+    void applyMove(int move);
+
+    /**
+     * Applies a compiled sequence of moves in one step.
+     * @param sequence The sequence to apply, which must be valid.
+     */
+    void applySequence(const CompiledSequence& sequence);
+
+    /**
+     * Performs a sequence of moves without recording them.
+     * @param moves A set of moves.
+     * @return Whether or not the moves were valid (invalid moves are not applied).
+     */
+    bool applyMoves(const string& moves);
+protected:
+    static const map<int, char> FACE_COLORS;
+    static const int NUM_FACES = 6;
+    static const int SIZE = 3;
+
+    /**
+     * Sets the stickers to a solved state.
+     */
+    void createSolved();
+
+    /**
+     * Gets the index of a facelet in the flat sticker array.
+     * @param face The index of the face.
+     * @param row The row of the facelet.
+     * @param col The column of the facelet.
+     * @return The index of the facelet.
+     */
+    static int getIndex(int face, int row, int col);
+
+    /**
+     * Gets the face, color, row, and column of a facelet.
+     * @param facelet The index of the facelet.
+     * @return The data of the sticker.
+     */
+    StickerData getStickerData(int facelet) const;
+
+    /**
+     * Gets the color of a facelet as seen from the cube's orientation.
+     * @param facelet The index of the facelet.
+     * @return The color of the facelet.
+     */
+    char getFacelet(int facelet) const;
+
+    /**
+     * Finds every edge and corner piece from the stickers, which is only needed when they are not set by moves.
+     * The pieces are not used if the stickers do not form one of each piece with their colors in a valid order.
+     */
+    void locatePieces();
+
+    // The stickers of the cube before any rotations, packed for FaceletKernel and followed by padding
+    alignas(FaceletKernel::PACKED_SIZE) char stickers[FaceletKernel::PACKED_SIZE];
+
+    // The facelet of each edge's first sticker and then each corner's, giving their slots and orientations (see FaceletAdjacency)
+    unsigned char locations[FaceletKernel::INDEX_SIZE];
+
+    unsigned char orientation;  // The orientation that the stickers are seen from
+    bool centered;              // Whether or not every center is on its own face of the stickers
+    bool located;               // Whether or not the locations match the stickers
+};
+
+static_assert(is_trivially_copyable<CubeState>::value, "CubeState must stay cheap to copy");
+static_assert(FaceletMoves::NUM_FACELETS == FaceletKernel::NUM_FACELETS, "The stickers must fill the start of a packed block");
+static_assert(CubieCube::NUM_EDGES + CubieCube::NUM_CORNERS <= FaceletKernel::INDEX_SIZE, "The locations must fit in an index block");
+
+#endif
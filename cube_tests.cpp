@@ -1,9 +1,17 @@
 #include "cube_tests.h"
 #include "tester.h"
 #include "cube.h"
+#include "cube_state.h"
 #include "sticker_data.h"
+#include "facelet_moves.h"
+#include "compiled_sequence.h"
+#include "move_parser.h"
+#include "move_history.h"
+#include "cube_batch.h"
+#include "facelet_kernel.h"
 #include <string>
 #include <utility>
+#include <vector>
 using namespace std;
 
 int CubeTests::runTests() const {
@@ -93,6 +101,29 @@ int CubeTests::runTests() const {
         tester.test("Moves are properly counted (clockwise/counterclockwise = 1, double moves = 2)", passed);
     }
 
+    // Test parsing moves with spaces between modifiers
+    {
+        vector<Move> moves;
+        int count = MoveParser::parse(" R '2 U\t2 x ", &moves);
+        bool passed = count == 5 && MoveParser::toString(moves, false) == "R'2U2x";
+        tester.test("Moves are parsed into single bytes while ignoring whitespace", passed);
+    }
+
+    // Test parsing misplaced modifiers
+    {
+        bool passed = MoveParser::parse("'R", nullptr) == -1 && MoveParser::parse("R2'", nullptr) == -1 && MoveParser::parse("R22", nullptr) == -1;
+        tester.test("Modifiers without a move or in the wrong order are invalid", passed);
+    }
+
+    // Test the table index of parsed moves
+    {
+        vector<Move> moves;
+        MoveParser::parse("UU'U2U'2", &moves);
+        bool passed = moves[0].getIndex() == FaceletMoves::getMove('U', 1) && moves[1].getIndex() == FaceletMoves::getMove('U', 3)
+            && moves[2].getIndex() == FaceletMoves::getMove('U', 2) && moves[3].getIndex() == FaceletMoves::getMove('U', 2);
+        tester.test("Parsed moves map to their permutation in the move tables", passed);
+    }
+
     // Test default constructor
     {
         Cube cube;
@@ -268,6 +299,42 @@ int CubeTests::runTests() const {
         tester.test("Corners not in their correct position are correctly regarded like so", passed);
     }
 
+    // Test finding pieces after moves, rotations, and restoring a snapshot
+    {
+        Cube cube;
+        cube.doMoves("RUF'xL2Dy'B", false);
+        CubeState restored;
+        restored.setSnapshot(cube.getSnapshot());
+
+        StickerData edge = cube.findEdge('G', 'R');
+        StickerData adjEdge = cube.getAdjEdge(edge.face, edge.row, edge.col);
+        pair<StickerData, pair<StickerData, StickerData>> corner = cube.findCorner('Y', { 'B', 'O' });
+        pair<StickerData, pair<StickerData, StickerData>> restoredCorner = restored.findCorner('Y', { 'B', 'O' });
+
+        bool passed = Cube::checkColors({ edge.color, adjEdge.color }, { 'G', 'R' })
+                    && cube.getAt(corner.first.face, corner.first.row, corner.first.col) == 'Y'
+                    && Cube::checkColors({ corner.second.first.color, corner.second.second.color }, { 'B', 'O' })
+                    && restoredCorner.first.face == corner.first.face && restoredCorner.first.row == corner.first.row
+                    && restoredCorner.first.col == corner.first.col && restored.findEdge('G', 'R').face == edge.face;
+        tester.test("Pieces are found where their stickers are after moves, rotations, and restoring a snapshot", passed);
+    }
+
+    // Test turning faces after rotating the whole cube
+    {
+        Cube rotated;
+        Cube turned;
+        rotated.doMoves("yRx'", false);
+        turned.doMoves("By", false);
+        turned.doMoves("x'", false);
+
+        CubeState restored;
+        restored.setSnapshot(rotated.getSnapshot());
+        bool passed = rotated.getSnapshot() == turned.getSnapshot() && restored.getSnapshot() == rotated.getSnapshot()
+                    && rotated.findCenter('G') == Cube::LEFT && rotated.findCenter('W') == Cube::FRONT
+                    && restored.findCenter('W') == Cube::FRONT && rotated.findCenter('x') == -1;
+        tester.test("Faces turned after a rotation are the faces seen from the rotated cube", passed);
+    }
+
     // Test checking if the Cube is solved when it is solved
     {
         Cube cube; // Solved by default
@@ -341,6 +408,58 @@ int CubeTests::runTests() const {
         tester.test("Performing moves functions as expected", passed);
     }
 
+    // Test that every move is cancelled out by its prime move
+    {
+        Cube cube;
+        bool passed = true;
+
+        for (char letter : FaceletMoves::MOVE_LETTERS) {
+            string move(1, letter);
+            cube.doMoves(move + move + "2" + move + "'2" + move + "'", false);
+            passed = passed && cube.checkSolved() && cube.getAt(Cube::TOP, 1, 1) == 'W';
+        }
+
+        tester.test("Every move is cancelled out by doing its double and prime moves", passed);
+    }
+
+    // Test that a sequence of moves with a known order returns to a solved state
+    {
+        Cube cube;
+        cube.doMoves("RUR'U'RUR'U'RUR'U'", false);
+        bool scrambled = !cube.checkSolved();
+        cube.doMoves("RUR'U'RUR'U'RUR'U'", false);
+        tester.test("Repeating a sequence of moves up to its order returns the cube to a solved state", scrambled && cube.checkSolved());
+    }
+
+    // Test performing a compiled sequence
+    {
+        Cube cube1;
+        Cube cube2;
+        CompiledSequence sequence("RUR'URU2R'");
+        cube1.doMoves(sequence, true);
+        cube2.doMoves("R U R' U R U2 R'", true);
+
+        bool passed = sequence.isValid() && sequence.getCount() == 8 && sequence.getTokenized() == "R U R' U R U2 R'"
+                    && cube1.getCubieCube() == cube2.getCubieCube() && cube1.getTotalMoves() == 8 && cube1.getCurrentMoves() == "RUR'URU2R'";
+        tester.test("Performing a compiled sequence has the same result as performing each of its moves", passed);
+    }
+
+    // Test compiling an invalid sequence
+    {
+        Cube cube;
+        CompiledSequence sequence("abcdRUR'URU2R'");
+        cube.doMoves(sequence, true);
+        tester.test("Compiled invalid sequences are marked as invalid and do nothing", !sequence.isValid() && cube.checkSolved());
+    }
+
+    // Test the compiled sequence cache
+    {
+        const CompiledSequence* first = CompiledSequence::getCached("FU'F'LF'L'FU");
+        const CompiledSequence* second = CompiledSequence::getCached("FU'F'LF'L'FU");
+        const CompiledSequence* tooLong = CompiledSequence::getCached(string(CompiledSequence::MAX_CACHED_LENGTH + 1, 'U'));
+        tester.test("Sequences are compiled once and reused, unless they are too long to cache", first != nullptr && first == second && tooLong == nullptr);
+    }
+
     // Test undoing moves after performing moves
     {
         Cube cube;
@@ -351,6 +470,127 @@ int CubeTests::runTests() const {
         tester.test("Undoing after performing moves results takes away a letter from the current moves", cube.getCurrentMoves() == expected);
     }
 
+    // Test undoing double moves
+    {
+        Cube cube;
+        Cube expected;
+        cube.doMoves("RU'2", true);
+        expected.doMoves("RU'", true);
+        string before = cube.getCurrentMoves();
+        cube.undo();
+        bool passed = before == "RU'2" && cube.getCurrentMoves() == "RU'" && cube.getTotalMoves() == 2 && cube == expected;
+        tester.test("Undoing a double move leaves a single move in the same direction", passed);
+    }
+
+    // Test the cached move history after undoing and performing moves
+    {
+        MoveHistory history;
+        vector<Move> moves;
+        MoveParser::parse("RU2F'", &moves);
+        history.push(moves);
+        string first = history.toString();
+        history.pop();
+        history.pop();
+        history.push(moves[2]);
+        bool passed = first == "RU2F'" && history.toString() == "RF'" && history.getCount() == 2 && history.size() == 2;
+        tester.test("The move history keeps its count and notation in sync with pushes and pops", passed);
+    }
+
+    // Test look-ahead on a copied state
+    {
+        Cube cube;
+        cube.doMoves("RUR'U'", true);
+        CubeState state = cube.getState();
+        bool valid = state.applyMoves("UR U'R'");
+        bool passed = valid && state.checkSolved() && !cube.checkSolved() && cube.getCurrentMoves() == "RUR'U'";
+        tester.test("Moves applied to a copied state do not affect the cube or its history", passed);
+    }
+
+    // Test restoring a cube from a snapshot
+    {
+        Cube cube("Test", "RDLF", "U", 1);
+        cube.doMoves("B2x", true);
+        Cube restored("Test", "RDLF", "UB2x", cube.getTotalMoves(), cube.getSnapshot());
+        bool passed = cube.getSnapshot().length() == Cube::SNAPSHOT_LENGTH && restored.getSnapshot() == cube.getSnapshot()
+            && restored.checkReplay() && cube.checkReplay();
+        tester.test("A cube restored from a snapshot has the same stickers as its replayed moves", passed);
+    }
+
+    // Test damaged snapshots
+    {
+        Cube cube("Test", "RDLF", "U", 1);
+        string snapshot = cube.getSnapshot();
+        snapshot[0] = (snapshot[0] == 'W') ? 'Y' : 'W';
+        CubeState state;
+        bool passed = !state.setSnapshot(snapshot) && !state.setSnapshot("") && state.checkSolved();
+
+        Cube replayed("Test", "RDLF", "U", 1, snapshot);
+        passed = passed && replayed.getSnapshot() == cube.getSnapshot();
+        tester.test("Damaged snapshots are rejected and the moves are replayed instead", passed);
+    }
+
+    // Test applying the same moves to a batch of cubes
+    {
+        const int NUM_CUBES = 70; // More than two blocks, so the last block is only partly used
+        string scrambles[] = { "RUR'U'", "xFy'B2", "L'D2zU", "" };
+        CubeBatch batch(NUM_CUBES);
+        vector<CubeState> states(NUM_CUBES);
+
+        for (int i = 0; i < NUM_CUBES; i++) {
+            states[i].applyMoves(scrambles[i % 4]);
+            batch.setCube(i, states[i]);
+        }
+
+        bool valid = batch.applyMoves("RU2x'F") && !batch.applyMoves("RQ");
+        bool passed = valid;
+
+        for (int i = 0; i < NUM_CUBES; i++) {
+            states[i].applyMoves("RU2x'F");
+            passed = passed && batch.getCube(i).getSnapshot() == states[i].getSnapshot();
+        }
+
+        tester.test("Moves applied to a batch of cubes match the moves applied to each cube", passed);
+    }
+
+    // Test checking which cubes of a batch are solved
+    {
+        CubeBatch batch(40);
+        CubeState scrambled;
+        scrambled.applyMoves("R");
+
+        for (int i = 0; i < batch.size(); i += 3) {
+            batch.setCube(i, scrambled);
+        }
+
+        bool passed = batch.countSolved() == 26 && !batch.checkSolved(0) && batch.checkSolved(1);
+        batch.applyMoves("y2L'y2"); // Undoes R by turning the same face from the other side
+        passed = passed && batch.countSolved() == 14 && batch.countSolved(3) == 1 && batch.checkSolved(0) && !batch.checkSolved(1);
+        tester.test("The solved cubes of a batch are found and counted", passed);
+    }
+
+    // Test that every supported kernel moves the stickers and pieces the same way
+    {
+        int original = FaceletKernel::getKernel();
+        FaceletKernel::setKernel(FaceletKernel::SCALAR);
+        Cube expected;
+        expected.doMoves("RUF'xL2Dy'B R2 z U' L", false);
+        bool passed = true;
+
+        for (int kernel : { FaceletKernel::SSSE3, FaceletKernel::VBMI }) {
+            if (!FaceletKernel::setKernel(kernel)) { continue; }
+
+            Cube cube;
+            cube.doMoves("RUF'xL2Dy'B R2 z U' L", false);
+            StickerData edge = cube.findEdge('G', 'R');
+            StickerData expectedEdge = expected.findEdge('G', 'R');
+            passed = passed && cube.getSnapshot() == expected.getSnapshot()
+                   && edge.face == expectedEdge.face && edge.row == expectedEdge.row && edge.col == expectedEdge.col;
+        }
+
+        FaceletKernel::setKernel(original);
+        tester.test("Every supported move kernel has the same result as the scalar kernel", passed);
+    }
+
     // Test undoing moves without moves done
     {
         Cube cube;
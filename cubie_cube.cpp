@@ -0,0 +1,299 @@
+#include "cubie_cube.h"
+#include "facelet_moves.h"
+#include "cube.h"
+#include "facelet_adjacency.h"
+#include <cstring>
+using namespace std;
+
+namespace {
+    const char DEFAULT_CENTERS[] = "WOGRBY"; // Same colors as a solved Cube
+    const int CENTER_FACELET = 4;
+
+    constexpr const unsigned char (&CORNER_FACELETS)[CubieCube::NUM_CORNERS][3] = FaceletAdjacency::CORNER_FACELETS;
+    constexpr const unsigned char (&EDGE_FACELETS)[CubieCube::NUM_EDGES][2] = FaceletAdjacency::EDGE_FACELETS;
+
+    /**
+     * Identifies the pieces of a facelet array, given which face each color belongs to.
+     * @param cubie The CubieCube to fill.
+     * @param facelets The facelets to read.
+     * @param colorFaces The home face of each color, -1 for unknown colors.
+     * @return Whether or not every piece could be identified.
+     */
+    bool readPieces(CubieCube& cubie, const char* facelets, const int* colorFaces) {
+        for (int i = 0; i < CubieCube::NUM_CORNERS; i++) {
+            int faces[3];
+            for (int j = 0; j < 3; j++) {
+                faces[j] = colorFaces[(unsigned char) facelets[CORNER_FACELETS[i][j]]];
+            }
+
+            // The orientation is the position of the top or bottom colored facelet.
+            int ori = 0;
+            while (ori < 3 && faces[ori] != Cube::TOP && faces[ori] != Cube::BOTTOM) {
+                ori++;
+            }
+            if (ori == 3) { return false; }
+
+            int found = -1;
+            for (int piece = 0; piece < CubieCube::NUM_CORNERS && found == -1; piece++) {
+                if (faces[(ori + 1) % 3] == CORNER_FACELETS[piece][1] / 9
+                && faces[(ori + 2) % 3] == CORNER_FACELETS[piece][2] / 9
+                && faces[ori] == CORNER_FACELETS[piece][0] / 9) {
+                    found = piece;
+                }
+            }
+            if (found == -1) { return false; }
+
+            cubie.cp[i] = found;
+            cubie.co[i] = ori;
+        }
+
+        for (int i = 0; i < CubieCube::NUM_EDGES; i++) {
+            int face0 = colorFaces[(unsigned char) facelets[EDGE_FACELETS[i][0]]];
+            int face1 = colorFaces[(unsigned char) facelets[EDGE_FACELETS[i][1]]];
+            int found = -1;
+
+            for (int piece = 0; piece < CubieCube::NUM_EDGES && found == -1; piece++) {
+                int home0 = EDGE_FACELETS[piece][0] / 9;
+                int home1 = EDGE_FACELETS[piece][1] / 9;
+
+                if (face0 == home0 && face1 == home1) {
+                    found = piece;
+                    cubie.eo[i] = 0;
+                } else if (face0 == home1 && face1 == home0) {
+                    found = piece;
+                    cubie.eo[i] = 1;
+                }
+            }
+            if (found == -1) { return false; }
+
+            cubie.ep[i] = found;
+        }
+
+        return true;
+    }
+
+    struct MoveTable {
+        CubieCube moves[FaceletMoves::NUM_MOVES];    // Face turns, and rotations as seen from a fixed frame
+        CubieCube inverses[FaceletMoves::NUM_MOVES];
+    };
+
+    /**
+     * Builds the cubie transform of every move from its facelet permutation, reading pieces against the solved frame.
+     * @return The table of transforms.
+     */
+    MoveTable buildMoveTable() {
+        MoveTable table;
+        int colorFaces[256];
+        memset(colorFaces, -1, sizeof(colorFaces));
+
+        for (int face = 0; face < CubieCube::NUM_CENTERS; face++) {
+            colorFaces[(unsigned char) DEFAULT_CENTERS[face]] = face;
+        }
+
+        for (int move = 0; move < FaceletMoves::NUM_MOVES; move++) {
+            CubieCube solved;
+            char facelets[FaceletMoves::NUM_FACELETS];
+            solved.getFacelets(facelets);
+            FaceletMoves::apply(facelets, move);
+
+            readPieces(table.moves[move], facelets, colorFaces);
+            table.inverses[move] = table.moves[move].getInverse();
+        }
+
+        return table;
+    }
+
+    const MoveTable& getMoveTable() {
+        static const MoveTable TABLE = buildMoveTable();
+        return TABLE;
+    }
+
+    /**
+     * Gets the parity of a permutation.
+     * @param perm The permutation.
+     * @param size The number of elements.
+     * @return 0 if the permutation is even, 1 if it is odd.
+     */
+    int getParity(const unsigned char* perm, int size) {
+        int inversions = 0;
+
+        for (int i = 0; i < size; i++) {
+            for (int j = i + 1; j < size; j++) {
+                if (perm[i] > perm[j]) {
+                    inversions++;
+                }
+            }
+        }
+
+        return inversions % 2;
+    }
+}
+
+CubieCube::CubieCube() {
+    for (int i = 0; i < NUM_CORNERS; i++) {
+        cp[i] = i;
+        co[i] = 0;
+    }
+
+    for (int i = 0; i < NUM_EDGES; i++) {
+        ep[i] = i;
+        eo[i] = 0;
+    }
+
+    memcpy(centers, DEFAULT_CENTERS, NUM_CENTERS);
+}
+
+bool CubieCube::setFacelets(const char* facelets) {
+    int colorFaces[256];
+    memset(colorFaces, -1, sizeof(colorFaces));
+
+    for (int face = 0; face < NUM_CENTERS; face++) {
+        centers[face] = facelets[face * 9 + CENTER_FACELET];
+        colorFaces[(unsigned char) centers[face]] = face;
+    }
+
+    return readPieces(*this, facelets, colorFaces);
+}
+
+void CubieCube::getFacelets(char* facelets) const {
+    for (int face = 0; face < NUM_CENTERS; face++) {
+        facelets[face * 9 + CENTER_FACELET] = centers[face];
+    }
+
+    // Each facelet takes the center color of the face its piece belongs to, shifted by the orientation.
+    for (int i = 0; i < NUM_CORNERS; i++) {
+        for (int j = 0; j < 3; j++) {
+            facelets[CORNER_FACELETS[i][(j + co[i]) % 3]] = centers[CORNER_FACELETS[cp[i]][j] / 9];
+        }
+    }
+
+    for (int i = 0; i < NUM_EDGES; i++) {
+        for (int j = 0; j < 2; j++) {
+            facelets[EDGE_FACELETS[i][(j + eo[i]) % 2]] = centers[EDGE_FACELETS[ep[i]][j] / 9];
+        }
+    }
+}
+
+void CubieCube::applyMove(int move) {
+    const MoveTable& table = getMoveTable();
+
+    if (move < FaceletMoves::NUM_FACE_MOVES) {
+        multiply(table.moves[move]);
+    } else {
+        // A rotation relabels every piece along with the centers, so the pieces are conjugated by it.
+        CubieCube res = table.inverses[move];
+        res.multiply(*this);
+        res.multiply(table.moves[move]);
+
+        const unsigned char* perm = FaceletMoves::getPermutation(move);
+        for (int face = 0; face < NUM_CENTERS; face++) {
+            res.centers[face] = centers[perm[face * 9 + CENTER_FACELET] / 9];
+        }
+
+        *this = res;
+    }
+}
+
+void CubieCube::multiply(const CubieCube& rhs) {
+    unsigned char newCp[NUM_CORNERS], newCo[NUM_CORNERS];
+    unsigned char newEp[NUM_EDGES], newEo[NUM_EDGES];
+
+    for (int i = 0; i < NUM_CORNERS; i++) {
+        newCp[i] = cp[rhs.cp[i]];
+        newCo[i] = (co[rhs.cp[i]] + rhs.co[i]) % 3;
+    }
+
+    for (int i = 0; i < NUM_EDGES; i++) {
+        newEp[i] = ep[rhs.ep[i]];
+        newEo[i] = (eo[rhs.ep[i]] + rhs.eo[i]) % 2;
+    }
+
+    memcpy(cp, newCp, NUM_CORNERS);
+    memcpy(co, newCo, NUM_CORNERS);
+    memcpy(ep, newEp, NUM_EDGES);
+    memcpy(eo, newEo, NUM_EDGES);
+}
+
+CubieCube CubieCube::getInverse() const {
+    CubieCube res;
+    memcpy(res.centers, centers, NUM_CENTERS);
+
+    for (int i = 0; i < NUM_CORNERS; i++) {
+        res.cp[cp[i]] = i;
+    }
+    for (int i = 0; i < NUM_CORNERS; i++) {
+        res.co[i] = (3 - co[res.cp[i]]) % 3;
+    }
+
+    for (int i = 0; i < NUM_EDGES; i++) {
+        res.ep[ep[i]] = i;
+    }
+    for (int i = 0; i < NUM_EDGES; i++) {
+        res.eo[i] = eo[res.ep[i]];
+    }
+
+    return res;
+}
+
+int CubieCube::findCorner(int corner) const {
+    for (int i = 0; i < NUM_CORNERS; i++) {
+        if (cp[i] == corner) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+int CubieCube::findEdge(int edge) const {
+    for (int i = 0; i < NUM_EDGES; i++) {
+        if (ep[i] == edge) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+int CubieCube::getCornerParity() const { return getParity(cp, NUM_CORNERS); }
+
+int CubieCube::getEdgeParity() const { return getParity(ep, NUM_EDGES); }
+
+bool CubieCube::verify() const {
+    bool seenCorners[NUM_CORNERS] = {};
+    bool seenEdges[NUM_EDGES] = {};
+    int twist = 0;
+    int flip = 0;
+
+    for (int i = 0; i < NUM_CORNERS; i++) {
+        if (cp[i] >= NUM_CORNERS || seenCorners[cp[i]] || co[i] > 2) { return false; }
+        seenCorners[cp[i]] = true;
+        twist += co[i];
+    }
+
+    for (int i = 0; i < NUM_EDGES; i++) {
+        if (ep[i] >= NUM_EDGES || seenEdges[ep[i]] || eo[i] > 1) { return false; }
+        seenEdges[ep[i]] = true;
+        flip += eo[i];
+    }
+
+    return twist % 3 == 0 && flip % 2 == 0 && getCornerParity() == getEdgeParity();
+}
+
+bool CubieCube::checkSolved() const {
+    for (int i = 0; i < NUM_CORNERS; i++) {
+        if (cp[i] != i || co[i] != 0) { return false; }
+    }
+
+    for (int i = 0; i < NUM_EDGES; i++) {
+        if (ep[i] != i || eo[i] != 0) { return false; }
+    }
+
+    return true;
+}
+
+bool CubieCube::operator==(const CubieCube& rhs) const {
+    return memcmp(cp, rhs.cp, NUM_CORNERS) == 0 && memcmp(co, rhs.co, NUM_CORNERS) == 0
+        && memcmp(ep, rhs.ep, NUM_EDGES) == 0 && memcmp(eo, rhs.eo, NUM_EDGES) == 0
+        && memcmp(centers, rhs.centers, NUM_CENTERS) == 0;
+}
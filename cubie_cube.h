@@ -0,0 +1,107 @@
+#ifndef CUBIE_CUBE_H
+#define CUBIE_CUBE_H
+
+using namespace std;
+
+class CubieCube {
+public:
+    enum Corners { URF, UFL, ULB, UBR, DFR, DLF, DBL, DRB };
+    enum Edges { UR, UF, UL, UB, DR, DF, DL, DB, FR, FL, BL, BR };
+    static const int NUM_CORNERS = 8;
+    static const int NUM_EDGES = 12;
+    static const int NUM_CENTERS = 6;
+
+    /**
+     * Constructor for CubieCube, which is solved with the default center colors.
+     */
+    CubieCube();
+
+    /**
+     * Sets the pieces from a flat array of 54 facelets (see FaceletMoves).
+     * Pieces are identified relative to the center colors, so a rotated cube is still solved.
+     * @param facelets The facelets to read.
+     * @return Whether or not every corner and edge could be identified.
+     */
+    bool setFacelets(const char* facelets);
+
+    /**
+     * Writes the pieces to a flat array of 54 facelets.
+     * @param facelets The facelets to write to.
+     */
+    void getFacelets(char* facelets) const;
+
+    /**
+     * Applies a move through its precomputed cubie transform.
+     * Face turns are composed with the move, and rotations are applied by conjugation.
+     * @param move The index of the move (see FaceletMoves).
+     */
+    void applyMove(int move);
+
+    /**
+     * Composes another CubieCube after this one (this = this * rhs).
+     * @param rhs The CubieCube to apply.
+     */
+    void multiply(const CubieCube& rhs);
+
+    /**
+     * Gets the inverse of the CubieCube, ignoring the centers.
+     * @return A CubieCube that undoes this one.
+     */
+    CubieCube getInverse() const;
+
+    /**
+     * Locates the slot of a corner piece.
+     * @param corner The corner piece to locate.
+     * @return The slot that contains the piece.
+     */
+    int findCorner(int corner) const;
+
+    /**
+     * Locates the slot of an edge piece.
+     * @param edge The edge piece to locate.
+     * @return The slot that contains the piece.
+     */
+    int findEdge(int edge) const;
+
+    /**
+     * Gets the parity of the corner permutation, which always equals the parity of the edge permutation.
+     * @return 0 if the corner permutation is even, 1 if it is odd.
+     */
+    int getCornerParity() const;
+
+    /**
+     * Gets the parity of the edge permutation.
+     * @return 0 if the edge permutation is even, 1 if it is odd.
+     */
+    int getEdgeParity() const;
+
+    /**
+     * Checks if the pieces form a state that can be reached by turning the cube.
+     * @return Whether or not the pieces are permutations with valid twist, flip, and parity.
+     */
+    bool verify() const;
+
+    /**
+     * Checks if every piece is in its slot and oriented.
+     * @return Whether or not the CubieCube is solved.
+     */
+    bool checkSolved() const;
+
+    /**
+     * Checks if CubieCubes are equal.
+     * @param rhs The CubieCube to check against.
+     * @return Whether the pieces and centers are equal or not.
+     */
+    bool operator==(const CubieCube& rhs) const;
+
+    // The piece in each slot and its orientation. Corners twist by 0-2, edges flip by 0-1.
+    unsigned char cp[NUM_CORNERS];
+    unsigned char co[NUM_CORNERS];
+    unsigned char ep[NUM_EDGES];
+    unsigned char eo[NUM_EDGES];
+
+    // The color of each center, ordered like Cube::Faces.
+    char centers[NUM_CENTERS];
+};
+
+#endif
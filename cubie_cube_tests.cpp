@@ -0,0 +1,110 @@
+#include "cubie_cube_tests.h"
+#include "tester.h"
+#include "cubie_cube.h"
+#include "facelet_moves.h"
+#include "cube.h"
+#include <string>
+#include <cstring>
+using namespace std;
+
+int CubieCubeTests::runTests() const {
+    Tester tester;
+
+    // Test default constructor
+    {
+        CubieCube cubie;
+        tester.test("Upon construction, the pieces are solved and valid", cubie.checkSolved() && cubie.verify());
+    }
+
+    // Test converting a solved cube to facelets
+    {
+        CubieCube cubie;
+        Cube cube;
+        char facelets[FaceletMoves::NUM_FACELETS];
+        cubie.getFacelets(facelets);
+
+        bool passed = true;
+        for (int i = 0; i < FaceletMoves::NUM_FACELETS; i++) {
+            passed = passed && facelets[i] == cube.getAt(i / 9, (i % 9) / 3, i % 3);
+        }
+
+        tester.test("A solved CubieCube has the same stickers as a solved Cube", passed);
+    }
+
+    // Test that cubie moves match sticker moves
+    {
+        Cube cube;
+        CubieCube cubie;
+        string letters = "RURURURxFByDLz";
+        int turns[] = { 1, 1, 3, 1, 1, 2, 3, 1, 1, 1, 3, 1, 2, 2 };
+        cube.doMoves("RUR'URU2R'xFBy'DL2z2", false);
+
+        for (int i = 0; i < letters.length(); i++) {
+            cubie.applyMove(FaceletMoves::getMove(letters[i], turns[i]));
+        }
+
+        tester.test("Applying moves to the pieces matches applying them to the stickers", cubie == cube.getCubieCube());
+    }
+
+    // Test converting to and from facelets
+    {
+        Cube cube;
+        cube.doMoves("FRUR'U'F'yLDB2x'R", false);
+        CubieCube cubie = cube.getCubieCube();
+        char facelets[FaceletMoves::NUM_FACELETS];
+        cubie.getFacelets(facelets);
+
+        CubieCube converted;
+        bool passed = converted.setFacelets(facelets) && converted == cubie && converted.verify();
+        tester.test("Converting pieces to facelets and back results in the same pieces", passed);
+    }
+
+    // Test reading invalid facelets
+    {
+        CubieCube cubie;
+        char facelets[FaceletMoves::NUM_FACELETS];
+        cubie.getFacelets(facelets);
+        facelets[0] = facelets[1] = 'Y'; // Two yellow stickers on one corner and edge of the top face
+        tester.test("Facelets that do not form valid pieces are rejected", !cubie.setFacelets(facelets));
+    }
+
+    // Test rotations leave a solved cube solved
+    {
+        CubieCube cubie;
+        cubie.applyMove(FaceletMoves::getMove('x', 1));
+        cubie.applyMove(FaceletMoves::getMove('y', 3));
+        bool passed = cubie.checkSolved() && cubie.centers[Cube::TOP] == 'G';
+        tester.test("Rotating a solved cube only moves its centers", passed);
+    }
+
+    // Test the inverse
+    {
+        Cube cube;
+        cube.doMoves("RUF'L2DB'", false);
+        CubieCube cubie = cube.getCubieCube();
+        cubie.multiply(cubie.getInverse());
+        tester.test("Multiplying pieces by their inverse results in a solved state", cubie.checkSolved());
+    }
+
+    // Test locating pieces
+    {
+        CubieCube cubie;
+        cubie.applyMove(FaceletMoves::getMove('U', 1));
+        bool passed = cubie.findCorner(CubieCube::URF) == CubieCube::UFL && cubie.findEdge(CubieCube::UR) == CubieCube::UF;
+        tester.test("Pieces are located in the slots they were turned to", passed);
+    }
+
+    // Test verifying an unreachable state
+    {
+        CubieCube cubie;
+        cubie.co[CubieCube::URF] = 1; // A single twisted corner
+        bool twisted = !cubie.verify();
+
+        cubie = CubieCube();
+        cubie.ep[CubieCube::UR] = CubieCube::UF; // A single swapped pair of edges
+        cubie.ep[CubieCube::UF] = CubieCube::UR;
+        tester.test("States that cannot be reached by turning are not valid", twisted && !cubie.verify());
+    }
+
+    return tester.finishTests();
+}
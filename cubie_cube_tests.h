@@ -0,0 +1,13 @@
+#ifndef CUBIE_CUBE_TESTS_H
+#define CUBIE_CUBE_TESTS_H
+
+class CubieCubeTests {
+public:
+    /**
+     * Runs CubieCube tests.
+     * @return 0 if they passed, 1 if they did not.
+     */
+    int runTests() const;
+};
+
+#endif
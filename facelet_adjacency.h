@@ -0,0 +1,129 @@
+#ifndef FACELET_ADJACENCY_H
+#define FACELET_ADJACENCY_H
+
+#include "cube_state.h"
+#include "cubie_cube.h"
+#include "facelet_moves.h"
+using namespace std;
+
+/**
+ * Gets the index of a facelet in a flat array of facelets.
+ * @param face The index of the face.
+ * @param row The row of the facelet.
+ * @param col The column of the facelet.
+ * @return The index of the facelet.
+ */
+constexpr unsigned char getFaceletIndex(int face, int row, int col) {
+    return face * 9 + row * 3 + col;
+}
+
+/**
+ * The facelets that share a piece with each facelet, built at compile time from the facelets of each slot.
+ * Facelets are indexed by face * 9 + row * 3 + col (see FaceletMoves).
+ */
+struct FaceletAdjacency {
+    // Facelets of each corner slot, starting with the top or bottom facelet and continuing clockwise.
+    static constexpr unsigned char CORNER_FACELETS[CubieCube::NUM_CORNERS][3] = {
+        { getFaceletIndex(CubeState::TOP, 2, 2), getFaceletIndex(CubeState::RIGHT, 0, 0), getFaceletIndex(CubeState::FRONT, 0, 2) },    // URF
+        { getFaceletIndex(CubeState::TOP, 2, 0), getFaceletIndex(CubeState::FRONT, 0, 0), getFaceletIndex(CubeState::LEFT, 0, 2) },     // UFL
+        { getFaceletIndex(CubeState::TOP, 0, 0), getFaceletIndex(CubeState::LEFT, 0, 0), getFaceletIndex(CubeState::BACK, 0, 2) },      // ULB
+        { getFaceletIndex(CubeState::TOP, 0, 2), getFaceletIndex(CubeState::BACK, 0, 0), getFaceletIndex(CubeState::RIGHT, 0, 2) },     // UBR
+        { getFaceletIndex(CubeState::BOTTOM, 0, 2), getFaceletIndex(CubeState::FRONT, 2, 2), getFaceletIndex(CubeState::RIGHT, 2, 0) }, // DFR
+        { getFaceletIndex(CubeState::BOTTOM, 0, 0), getFaceletIndex(CubeState::LEFT, 2, 2), getFaceletIndex(CubeState::FRONT, 2, 0) },  // DLF
+        { getFaceletIndex(CubeState::BOTTOM, 2, 0), getFaceletIndex(CubeState::BACK, 2, 2), getFaceletIndex(CubeState::LEFT, 2, 0) },   // DBL
+        { getFaceletIndex(CubeState::BOTTOM, 2, 2), getFaceletIndex(CubeState::RIGHT, 2, 2), getFaceletIndex(CubeState::BACK, 2, 0) }   // DRB
+    };
+
+    // Facelets of each edge slot, starting with the top, bottom, front, or back facelet.
+    static constexpr unsigned char EDGE_FACELETS[CubieCube::NUM_EDGES][2] = {
+        { getFaceletIndex(CubeState::TOP, 1, 2), getFaceletIndex(CubeState::RIGHT, 0, 1) },    // UR
+        { getFaceletIndex(CubeState::TOP, 2, 1), getFaceletIndex(CubeState::FRONT, 0, 1) },    // UF
+        { getFaceletIndex(CubeState::TOP, 1, 0), getFaceletIndex(CubeState::LEFT, 0, 1) },     // UL
+        { getFaceletIndex(CubeState::TOP, 0, 1), getFaceletIndex(CubeState::BACK, 0, 1) },     // UB
+        { getFaceletIndex(CubeState::BOTTOM, 1, 2), getFaceletIndex(CubeState::RIGHT, 2, 1) }, // DR
+        { getFaceletIndex(CubeState::BOTTOM, 0, 1), getFaceletIndex(CubeState::FRONT, 2, 1) }, // DF
+        { getFaceletIndex(CubeState::BOTTOM, 1, 0), getFaceletIndex(CubeState::LEFT, 2, 1) },  // DL
+        { getFaceletIndex(CubeState::BOTTOM, 2, 1), getFaceletIndex(CubeState::BACK, 2, 1) },  // DB
+        { getFaceletIndex(CubeState::FRONT, 1, 2), getFaceletIndex(CubeState::RIGHT, 1, 0) },  // FR
+        { getFaceletIndex(CubeState::FRONT, 1, 0), getFaceletIndex(CubeState::LEFT, 1, 2) },   // FL
+        { getFaceletIndex(CubeState::BACK, 1, 2), getFaceletIndex(CubeState::LEFT, 1, 0) },    // BL
+        { getFaceletIndex(CubeState::BACK, 1, 0), getFaceletIndex(CubeState::RIGHT, 1, 2) }    // BR
+    };
+
+    // The other facelet of each edge facelet's piece. Other facelets get the one of their face's bottom edge.
+    unsigned char edges[FaceletMoves::NUM_FACELETS];
+
+    // The other facelets of each corner facelet's piece. From the top face, the left or right facelet comes first,
+    // from the bottom face, the front or back facelet, and from the sides, the top or bottom facelet.
+    // Other facelets get the ones of their face's bottom right corner.
+    unsigned char corners[FaceletMoves::NUM_FACELETS][2];
+
+    // The slot of each edge or corner facelet, and its index among the facelets of the slot (its orientation).
+    unsigned char slots[FaceletMoves::NUM_FACELETS];
+    unsigned char orientations[FaceletMoves::NUM_FACELETS];
+
+    // The edge or corner whose home faces are given by a mask of bits (1 << face), -1 if there is none.
+    // Edges have two bits and corners have three, so they never share a mask.
+    signed char pieces[1 << 6];
+
+    /**
+     * Builds the tables from the facelets of each slot.
+     */
+    constexpr FaceletAdjacency() : edges(), corners(), slots(), orientations(), pieces() {
+        for (int i = 0; i < (1 << 6); i++) {
+            pieces[i] = -1;
+        }
+
+        for (int i = 0; i < CubieCube::NUM_EDGES; i++) {
+            edges[EDGE_FACELETS[i][0]] = EDGE_FACELETS[i][1];
+            edges[EDGE_FACELETS[i][1]] = EDGE_FACELETS[i][0];
+            pieces[(1 << (EDGE_FACELETS[i][0] / 9)) | (1 << (EDGE_FACELETS[i][1] / 9))] = i;
+
+            for (int j = 0; j < 2; j++) {
+                slots[EDGE_FACELETS[i][j]] = i;
+                orientations[EDGE_FACELETS[i][j]] = j;
+            }
+        }
+
+        for (int i = 0; i < CubieCube::NUM_CORNERS; i++) {
+            pieces[(1 << (CORNER_FACELETS[i][0] / 9)) | (1 << (CORNER_FACELETS[i][1] / 9)) | (1 << (CORNER_FACELETS[i][2] / 9))] = i;
+
+            for (int j = 0; j < 3; j++) {
+                int facelet = CORNER_FACELETS[i][j];
+                slots[facelet] = i;
+                orientations[facelet] = j;
+                int other1 = CORNER_FACELETS[i][(j + 1) % 3];
+                int other2 = CORNER_FACELETS[i][(j + 2) % 3];
+                int firstFaces[2] = { CubeState::TOP, CubeState::BOTTOM }; // The faces that come first from a side
+
+                if (facelet / 9 == CubeState::TOP) {
+                    firstFaces[0] = CubeState::LEFT;
+                    firstFaces[1] = CubeState::RIGHT;
+                } else if (facelet / 9 == CubeState::BOTTOM) {
+                    firstFaces[0] = CubeState::FRONT;
+                    firstFaces[1] = CubeState::BACK;
+                }
+
+                bool otherFirst = other1 / 9 == firstFaces[0] || other1 / 9 == firstFaces[1];
+                corners[facelet][0] = otherFirst ? other1 : other2;
+                corners[facelet][1] = otherFirst ? other2 : other1;
+            }
+        }
+
+        for (int facelet = 0; facelet < FaceletMoves::NUM_FACELETS; facelet++) {
+            int face = facelet / 9;
+            int pos = facelet % 9;
+
+            if (pos % 2 == 0) { // Corners and centers
+                edges[facelet] = edges[getFaceletIndex(face, 2, 1)];
+            }
+
+            if (pos % 2 == 1 || pos == 4) { // Edges and centers
+                corners[facelet][0] = corners[getFaceletIndex(face, 2, 2)][0];
+                corners[facelet][1] = corners[getFaceletIndex(face, 2, 2)][1];
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,149 @@
+#include "facelet_kernel.h"
+#include <string>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FACELET_KERNEL_X86
+#endif
+using namespace std;
+
+namespace {
+    /**
+     * Finds the fastest kernel that the CPU supports.
+     * @return A value of FaceletKernel::Kernels.
+     */
+    int detectKernel() {
+        if (FaceletKernel::checkSupported(FaceletKernel::VBMI)) {
+            return FaceletKernel::VBMI;
+        } else if (FaceletKernel::checkSupported(FaceletKernel::SSSE3)) {
+            return FaceletKernel::SSSE3;
+        }
+
+        return FaceletKernel::SCALAR;
+    }
+
+    // Anything that permutes before this is initialized uses the scalar kernel, which is 0.
+    int selectedKernel = detectKernel();
+
+#ifdef FACELET_KERNEL_X86
+    /**
+     * Looks up 16 indices in a table of four 16-byte chunks. Each chunk is shuffled by the low 4 bits of the indices,
+     * and only kept for the indices whose next 2 bits select it.
+     * @param table The chunks of the table.
+     * @param indices The indices, each less than 64.
+     * @return The entries of the table.
+     */
+    __attribute__((target("ssse3")))
+    inline __m128i lookupChunk(const __m128i* table, __m128i indices) {
+        __m128i chunks = _mm_and_si128(indices, _mm_set1_epi8(0x30));
+        __m128i res = _mm_setzero_si128();
+
+        for (int i = 0; i < 4; i++) {
+            __m128i selected = _mm_cmpeq_epi8(chunks, _mm_set1_epi8(i * 16));
+            res = _mm_or_si128(res, _mm_and_si128(_mm_shuffle_epi8(table[i], indices), selected));
+        }
+
+        return res;
+    }
+
+    __attribute__((target("ssse3")))
+    void permuteSSSE3(char* facelets, const unsigned char* permutation) {
+        const __m128i* src = (const __m128i*) facelets;
+        const __m128i* perm = (const __m128i*) permutation;
+        __m128i table[4] = { _mm_load_si128(src), _mm_load_si128(src + 1), _mm_load_si128(src + 2), _mm_load_si128(src + 3) };
+
+        for (int i = 0; i < 4; i++) {
+            _mm_store_si128((__m128i*) facelets + i, lookupChunk(table, _mm_load_si128(perm + i)));
+        }
+    }
+
+    __attribute__((target("ssse3")))
+    void lookupSSSE3(unsigned char* indices, const unsigned char* table) {
+        const __m128i* src = (const __m128i*) table;
+        __m128i chunks[4] = { _mm_load_si128(src), _mm_load_si128(src + 1), _mm_load_si128(src + 2), _mm_load_si128(src + 3) };
+
+        for (int i = 0; i < FaceletKernel::INDEX_SIZE; i += 16) {
+            __m128i* dest = (__m128i*) (indices + i);
+            _mm_storeu_si128(dest, lookupChunk(chunks, _mm_loadu_si128(dest)));
+        }
+    }
+
+    __attribute__((target("avx512f,avx512bw,avx512vbmi")))
+    void permuteVBMI(char* facelets, const unsigned char* permutation) {
+        __m512i perm = _mm512_load_si512(permutation);
+        _mm512_store_si512(facelets, _mm512_permutexvar_epi8(perm, _mm512_load_si512(facelets)));
+    }
+
+    __attribute__((target("avx512f,avx512bw,avx512vbmi")))
+    void lookupVBMI(unsigned char* indices, const unsigned char* table) {
+        __m512i idx = _mm512_castsi256_si512(_mm256_loadu_si256((const __m256i*) indices));
+        __m512i res = _mm512_permutexvar_epi8(idx, _mm512_load_si512(table));
+        _mm256_storeu_si256((__m256i*) indices, _mm512_castsi512_si256(res));
+    }
+#endif
+}
+
+int FaceletKernel::getKernel() { return selectedKernel; }
+
+bool FaceletKernel::setKernel(int kernel) {
+    if (!checkSupported(kernel)) { return false; }
+
+    selectedKernel = kernel;
+    return true;
+}
+
+bool FaceletKernel::checkSupported(int kernel) {
+#ifdef FACELET_KERNEL_X86
+    if (kernel == SSSE3) {
+        return __builtin_cpu_supports("ssse3");
+    } else if (kernel == VBMI) {
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vbmi");
+    }
+#endif
+
+    return kernel == SCALAR;
+}
+
+string FaceletKernel::getName(int kernel) {
+    switch (kernel) {
+        case SSSE3: return "SSSE3";
+        case VBMI:  return "AVX-512 VBMI";
+        default:    return "scalar";
+    }
+}
+
+void FaceletKernel::permute(char* facelets, const unsigned char* permutation) {
+#ifdef FACELET_KERNEL_X86
+    if (selectedKernel == VBMI) {
+        permuteVBMI(facelets, permutation);
+        return;
+    } else if (selectedKernel == SSSE3) {
+        permuteSSSE3(facelets, permutation);
+        return;
+    }
+#endif
+
+    // The padding maps to itself, so only the facelets are moved.
+    char original[NUM_FACELETS];
+    memcpy(original, facelets, NUM_FACELETS);
+
+    for (int i = 0; i < NUM_FACELETS; i++) {
+        facelets[i] = original[permutation[i]];
+    }
+}
+
+void FaceletKernel::lookup(unsigned char* indices, const unsigned char* table) {
+#ifdef FACELET_KERNEL_X86
+    if (selectedKernel == VBMI) {
+        lookupVBMI(indices, table);
+        return;
+    } else if (selectedKernel == SSSE3) {
+        lookupSSSE3(indices, table);
+        return;
+    }
+#endif
+
+    for (int i = 0; i < INDEX_SIZE; i++) {
+        indices[i] = table[indices[i]];
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef FACELET_KERNEL_H
+#define FACELET_KERNEL_H
+
+#include <string>
+using namespace std;
+
+/**
+ * Permutes packed facelets with byte shuffles, using the fastest kernel that the CPU supports.
+ * Facelets are packed into a 64-byte aligned block whose last 10 bytes are padding, and permutations are padded to 64
+ * entries that leave the padding in place (see FaceletMoves::getPackedPermutation). With AVX-512 VBMI a permutation is
+ * a single vpermb, with SSSE3 each 16-byte chunk is gathered from the four chunks with pshufb, and otherwise it is a
+ * scalar loop. The kernel is chosen when the program starts.
+ */
+class FaceletKernel {
+public:
+    enum Kernels { SCALAR, SSSE3, VBMI };
+    static const int PACKED_SIZE = 64;  // The number of bytes of packed facelets and of a packed permutation
+    static const int NUM_FACELETS = 54; // The number of packed bytes that hold facelets, before the padding
+    static const int INDEX_SIZE = 32;   // The number of bytes of an index block read through a table
+
+    /**
+     * Gets the kernel in use.
+     * @return A value of Kernels.
+     */
+    static int getKernel();
+
+    /**
+     * Selects the kernel to use, if the CPU supports it.
+     * @param kernel A value of Kernels.
+     * @return Whether or not the kernel is supported (the kernel in use is unchanged if it is not).
+     */
+    static bool setKernel(int kernel);
+
+    /**
+     * Checks if the CPU supports a kernel.
+     * @param kernel A value of Kernels.
+     * @return Whether or not the kernel can be used.
+     */
+    static bool checkSupported(int kernel);
+
+    /**
+     * Gets the name of a kernel.
+     * @param kernel A value of Kernels.
+     * @return The name of the kernel.
+     */
+    static string getName(int kernel);
+
+    /**
+     * Permutes packed facelets in place.
+     * @param facelets The 64-byte aligned facelets to permute.
+     * @param permutation The 64-byte aligned permutation, where facelet i receives the facelet at permutation[i].
+     */
+    static void permute(char* facelets, const unsigned char* permutation);
+
+    /**
+     * Replaces each byte of an index block with the entry of a table that it indexes.
+     * @param indices The 32 indices to replace, each less than 64.
+     * @param table The 64-byte aligned table, such as a packed permutation.
+     */
+    static void lookup(unsigned char* indices, const unsigned char* table);
+};
+
+#endif
@@ -0,0 +1,338 @@
+#include "facelet_moves.h"
+#include "cube.h"
+#include "facelet_kernel.h"
+#include <string>
+#include <cstring>
+using namespace std;
+
+const string FaceletMoves::MOVE_LETTERS = "ULFRBDxyz";
+
+namespace {
+    const int FACE_SIZE = 9;
+    const int OPPOSITE_FACES[] = { Cube::BOTTOM, Cube::RIGHT, Cube::BACK, Cube::LEFT, Cube::FRONT, Cube::TOP };
+    enum Transforms { SAME, CLOCKWISE, HALF, COUNTERCLOCKWISE };
+
+    struct PermutationTable {
+        unsigned char perms[FaceletMoves::NUM_MOVES][FaceletMoves::NUM_FACELETS];
+    };
+
+    constexpr int index(int face, int row, int col) {
+        return face * FACE_SIZE + row * 3 + col;
+    }
+
+    /**
+     * Gets a facelet of a row or column of a face.
+     * @param face The face of the segment.
+     * @param isRow Whether the segment is a row or a column.
+     * @param line The row or column of the segment.
+     * @param i The position within the segment.
+     * @return The index of the facelet.
+     */
+    constexpr int segmentAt(int face, bool isRow, int line, int i) {
+        return isRow ? index(face, line, i) : index(face, i, line);
+    }
+
+    /**
+     * Makes a segment of a face receive the facelets of another segment.
+     * @param perm The permutation to update.
+     * @param face The face receiving the segment.
+     * @param isRow Whether the receiving segment is a row.
+     * @param line The row or column receiving the segment.
+     * @param srcFace The face giving the segment.
+     * @param srcIsRow Whether the given segment is a row.
+     * @param srcLine The row or column giving the segment.
+     * @param reversed Whether the given segment is read in reverse.
+     */
+    constexpr void placeSegment(unsigned char* perm, int face, bool isRow, int line,
+                                int srcFace, bool srcIsRow, int srcLine, bool reversed) {
+        for (int i = 0; i < 3; i++) {
+            perm[segmentAt(face, isRow, line, i)] = segmentAt(srcFace, srcIsRow, srcLine, reversed ? 2 - i : i);
+        }
+    }
+
+    /**
+     * Makes a face receive the facelets of another face, turned by a given transform.
+     * @param perm The permutation to update.
+     * @param face The face receiving the facelets.
+     * @param srcFace The face giving the facelets.
+     * @param transform How the given face is turned (clockwise, half, or counterclockwise).
+     */
+    constexpr void placeFace(unsigned char* perm, int face, int srcFace, int transform) {
+        for (int row = 0; row < 3; row++) {
+            for (int col = 0; col < 3; col++) {
+                int src = 0;
+
+                switch (transform) {
+                    case SAME:             src = index(srcFace, row, col); break;
+                    case CLOCKWISE:        src = index(srcFace, 2 - col, row); break;
+                    case HALF:             src = index(srcFace, 2 - row, 2 - col); break;
+                    case COUNTERCLOCKWISE: src = index(srcFace, col, 2 - row); break;
+                }
+
+                perm[index(face, row, col)] = src;
+            }
+        }
+    }
+
+    /**
+     * Builds the permutation of a clockwise quarter turn or rotation.
+     * @param perm The permutation to fill.
+     * @param letter The index of the letter in FaceletMoves::MOVE_LETTERS.
+     */
+    constexpr void buildQuarterTurn(unsigned char* perm, int letter) {
+        for (int i = 0; i < FaceletMoves::NUM_FACELETS; i++) {
+            perm[i] = i;
+        }
+
+        switch (letter) {
+            case 0: // U: the top rows of the side faces move from right to left
+                placeFace(perm, Cube::TOP, Cube::TOP, CLOCKWISE);
+                placeSegment(perm, Cube::FRONT, true, 0, Cube::RIGHT, true, 0, false);
+                placeSegment(perm, Cube::RIGHT, true, 0, Cube::BACK, true, 0, false);
+                placeSegment(perm, Cube::BACK, true, 0, Cube::LEFT, true, 0, false);
+                placeSegment(perm, Cube::LEFT, true, 0, Cube::FRONT, true, 0, false);
+                break;
+            case 1: // L: top (leftmost) -> front -> bottom -> back (rightmost)
+                placeFace(perm, Cube::LEFT, Cube::LEFT, CLOCKWISE);
+                placeSegment(perm, Cube::TOP, false, 0, Cube::BACK, false, 2, true);
+                placeSegment(perm, Cube::FRONT, false, 0, Cube::TOP, false, 0, false);
+                placeSegment(perm, Cube::BOTTOM, false, 0, Cube::FRONT, false, 0, false);
+                placeSegment(perm, Cube::BACK, false, 2, Cube::BOTTOM, false, 0, true);
+                break;
+            case 2: // F: top (bottom row) -> right (leftmost) -> bottom (top row) -> left (rightmost)
+                placeFace(perm, Cube::FRONT, Cube::FRONT, CLOCKWISE);
+                placeSegment(perm, Cube::TOP, true, 2, Cube::LEFT, false, 2, true);
+                placeSegment(perm, Cube::RIGHT, false, 0, Cube::TOP, true, 2, false);
+                placeSegment(perm, Cube::BOTTOM, true, 0, Cube::RIGHT, false, 0, true);
+                placeSegment(perm, Cube::LEFT, false, 2, Cube::BOTTOM, true, 0, false);
+                break;
+            case 3: // R: front (rightmost) -> top -> back (leftmost) -> bottom
+                placeFace(perm, Cube::RIGHT, Cube::RIGHT, CLOCKWISE);
+                placeSegment(perm, Cube::TOP, false, 2, Cube::FRONT, false, 2, false);
+                placeSegment(perm, Cube::FRONT, false, 2, Cube::BOTTOM, false, 2, false);
+                placeSegment(perm, Cube::BOTTOM, false, 2, Cube::BACK, false, 0, true);
+                placeSegment(perm, Cube::BACK, false, 0, Cube::TOP, false, 2, true);
+                break;
+            case 4: // B: right (rightmost) -> top (top row) -> left (leftmost) -> bottom (bottom row)
+                placeFace(perm, Cube::BACK, Cube::BACK, CLOCKWISE);
+                placeSegment(perm, Cube::TOP, true, 0, Cube::RIGHT, false, 2, false);
+                placeSegment(perm, Cube::RIGHT, false, 2, Cube::BOTTOM, true, 2, true);
+                placeSegment(perm, Cube::BOTTOM, true, 2, Cube::LEFT, false, 0, false);
+                placeSegment(perm, Cube::LEFT, false, 0, Cube::TOP, true, 0, true);
+                break;
+            case 5: // D: the bottom rows of the side faces move from left to right
+                placeFace(perm, Cube::BOTTOM, Cube::BOTTOM, CLOCKWISE);
+                placeSegment(perm, Cube::FRONT, true, 2, Cube::LEFT, true, 2, false);
+                placeSegment(perm, Cube::RIGHT, true, 2, Cube::FRONT, true, 2, false);
+                placeSegment(perm, Cube::BACK, true, 2, Cube::RIGHT, true, 2, false);
+                placeSegment(perm, Cube::LEFT, true, 2, Cube::BACK, true, 2, false);
+                break;
+            case 6: // x: front -> top -> back -> bottom -> front
+                placeFace(perm, Cube::LEFT, Cube::LEFT, COUNTERCLOCKWISE);
+                placeFace(perm, Cube::RIGHT, Cube::RIGHT, CLOCKWISE);
+                placeFace(perm, Cube::TOP, Cube::FRONT, SAME);
+                placeFace(perm, Cube::FRONT, Cube::BOTTOM, SAME);
+                placeFace(perm, Cube::BOTTOM, Cube::BACK, HALF);
+                placeFace(perm, Cube::BACK, Cube::TOP, HALF);
+                break;
+            case 7: // y: front -> left -> back -> right -> front
+                placeFace(perm, Cube::TOP, Cube::TOP, CLOCKWISE);
+                placeFace(perm, Cube::BOTTOM, Cube::BOTTOM, COUNTERCLOCKWISE);
+                placeFace(perm, Cube::LEFT, Cube::FRONT, SAME);
+                placeFace(perm, Cube::FRONT, Cube::RIGHT, SAME);
+                placeFace(perm, Cube::RIGHT, Cube::BACK, SAME);
+                placeFace(perm, Cube::BACK, Cube::LEFT, SAME);
+                break;
+            case 8: // z: top -> right -> bottom -> left -> top
+                placeFace(perm, Cube::FRONT, Cube::FRONT, CLOCKWISE);
+                placeFace(perm, Cube::BACK, Cube::BACK, COUNTERCLOCKWISE);
+                placeFace(perm, Cube::RIGHT, Cube::TOP, CLOCKWISE);
+                placeFace(perm, Cube::TOP, Cube::LEFT, CLOCKWISE);
+                placeFace(perm, Cube::LEFT, Cube::BOTTOM, CLOCKWISE);
+                placeFace(perm, Cube::BOTTOM, Cube::RIGHT, CLOCKWISE);
+                break;
+        }
+    }
+
+    /**
+     * Builds the permutations of every move. Double and prime moves are the quarter turn composed with itself.
+     * @return A table with a permutation for every move.
+     */
+    constexpr PermutationTable buildTable() {
+        PermutationTable table = {};
+
+        for (int letter = 0; letter < FaceletMoves::NUM_LETTERS; letter++) {
+            unsigned char* quarter = table.perms[letter * 3];
+            buildQuarterTurn(quarter, letter);
+
+            for (int turns = 2; turns <= 3; turns++) {
+                unsigned char* prev = table.perms[letter * 3 + turns - 2];
+                unsigned char* perm = table.perms[letter * 3 + turns - 1];
+
+                for (int i = 0; i < FaceletMoves::NUM_FACELETS; i++) {
+                    perm[i] = prev[quarter[i]];
+                }
+            }
+        }
+
+        return table;
+    }
+
+    constexpr PermutationTable TABLE = buildTable();
+
+    struct PackedTable {
+        alignas(FaceletKernel::PACKED_SIZE) unsigned char perms[FaceletMoves::NUM_MOVES][FaceletKernel::PACKED_SIZE];
+    };
+
+    /**
+     * Pads the permutation of every move to the size of packed facelets.
+     * @return A table with a packed permutation for every move.
+     */
+    constexpr PackedTable buildPackedTable() {
+        PackedTable table = {};
+
+        for (int move = 0; move < FaceletMoves::NUM_MOVES; move++) {
+            for (int i = 0; i < FaceletKernel::PACKED_SIZE; i++) {
+                table.perms[move][i] = (i < FaceletMoves::NUM_FACELETS) ? TABLE.perms[move][i] : i;
+            }
+        }
+
+        return table;
+    }
+
+    constexpr PackedTable PACKED_TABLE = buildPackedTable();
+
+    struct FrameTable {
+        unsigned char frames[FaceletMoves::NUM_ORIENTATIONS][FaceletMoves::NUM_FACELETS];
+        unsigned char inverses[FaceletMoves::NUM_ORIENTATIONS][FaceletMoves::NUM_FACELETS];
+        unsigned char rotations[FaceletMoves::NUM_ORIENTATIONS][FaceletMoves::NUM_MOVES - FaceletMoves::NUM_FACE_MOVES];
+        unsigned char faceMoves[FaceletMoves::NUM_ORIENTATIONS][FaceletMoves::NUM_FACE_MOVES];
+        unsigned char combined[FaceletMoves::NUM_ORIENTATIONS][FaceletMoves::NUM_ORIENTATIONS];
+    };
+
+    /**
+     * Builds every orientation by applying each rotation to the orientations found so far, starting from no rotation.
+     * @return A table with the frame of every orientation and how rotations and face turns act on it.
+     */
+    constexpr FrameTable buildFrames() {
+        FrameTable table = {};
+        int found = 1;
+
+        for (int i = 0; i < FaceletMoves::NUM_FACELETS; i++) {
+            table.frames[0][i] = i;
+        }
+
+        for (int orientation = 0; orientation < found; orientation++) {
+            for (int rotation = 0; rotation < FaceletMoves::NUM_MOVES - FaceletMoves::NUM_FACE_MOVES; rotation++) {
+                const unsigned char* perm = TABLE.perms[FaceletMoves::NUM_FACE_MOVES + rotation];
+                unsigned char frame[FaceletMoves::NUM_FACELETS] = {};
+
+                // The rotated cube sees each facelet where the rotation takes it from.
+                for (int i = 0; i < FaceletMoves::NUM_FACELETS; i++) {
+                    frame[i] = table.frames[orientation][perm[i]];
+                }
+
+                int match = 0;
+                bool same = false;
+                for (; match < found && !same; match++) {
+                    same = true;
+                    for (int i = 0; i < FaceletMoves::NUM_FACELETS && same; i++) {
+                        same = frame[i] == table.frames[match][i];
+                    }
+                }
+
+                if (!same) {
+                    for (int i = 0; i < FaceletMoves::NUM_FACELETS; i++) {
+                        table.frames[found][i] = frame[i];
+                    }
+
+                    match = ++found;
+                }
+
+                table.rotations[orientation][rotation] = match - 1;
+            }
+        }
+
+        for (int orientation = 0; orientation < FaceletMoves::NUM_ORIENTATIONS; orientation++) {
+            for (int i = 0; i < FaceletMoves::NUM_FACELETS; i++) {
+                table.inverses[orientation][table.frames[orientation][i]] = i;
+            }
+
+            // The rotations of another orientation lead to the same orientation when they follow this one.
+            for (int rotation = 0; rotation < FaceletMoves::NUM_ORIENTATIONS; rotation++) {
+                int match = 0;
+                bool same = false;
+
+                for (; match < FaceletMoves::NUM_ORIENTATIONS && !same; match++) {
+                    same = true;
+                    for (int i = 0; i < FaceletMoves::NUM_FACELETS && same; i++) {
+                        same = table.frames[orientation][table.frames[rotation][i]] == table.frames[match][i];
+                    }
+                }
+
+                table.combined[orientation][rotation] = match - 1;
+            }
+
+            // Turning a face turns the face that its center is on, by the same amount.
+            for (int move = 0; move < FaceletMoves::NUM_FACE_MOVES; move++) {
+                int center = table.frames[orientation][(move / 3) * FACE_SIZE + 4];
+                table.faceMoves[orientation][move] = (center / FACE_SIZE) * 3 + move % 3;
+            }
+        }
+
+        return table;
+    }
+
+    constexpr FrameTable FRAMES = buildFrames();
+}
+
+int FaceletMoves::getMove(char letter, int turns) {
+    size_t letterIdx = MOVE_LETTERS.find(letter);
+
+    if (letterIdx == string::npos || turns < 1 || turns > 3) {
+        return -1;
+    }
+
+    return letterIdx * 3 + turns - 1;
+}
+
+char FaceletMoves::getLetter(int move) { return MOVE_LETTERS[move / 3]; }
+
+int FaceletMoves::getTurns(int move) { return move % 3 + 1; }
+
+int FaceletMoves::getInverse(int move) { return (move / 3) * 3 + (2 - move % 3); }
+
+bool FaceletMoves::checkFollows(int move, int previous) {
+    if (previous == -1) { return true; }
+
+    int face = move / 3;
+    int previousFace = previous / 3;
+    return face != previousFace && !(face == OPPOSITE_FACES[previousFace] && face < previousFace);
+}
+
+const unsigned char* FaceletMoves::getPermutation(int move) { return TABLE.perms[move]; }
+
+const unsigned char* FaceletMoves::getPackedPermutation(int move) { return PACKED_TABLE.perms[move]; }
+
+void FaceletMoves::apply(char* facelets, int move) {
+    applyPermutation(facelets, TABLE.perms[move]);
+}
+
+void FaceletMoves::applyPermutation(char* facelets, const unsigned char* permutation) {
+    char original[NUM_FACELETS];
+    memcpy(original, facelets, NUM_FACELETS);
+
+    for (int i = 0; i < NUM_FACELETS; i++) {
+        facelets[i] = original[permutation[i]];
+    }
+}
+
+const unsigned char* FaceletMoves::getFrame(int orientation) { return FRAMES.frames[orientation]; }
+
+const unsigned char* FaceletMoves::getFrameInverse(int orientation) { return FRAMES.inverses[orientation]; }
+
+int FaceletMoves::rotate(int orientation, int move) { return FRAMES.rotations[orientation][move - NUM_FACE_MOVES]; }
+
+int FaceletMoves::combine(int orientation, int rotation) { return FRAMES.combined[orientation][rotation]; }
+
+int FaceletMoves::getFrameMove(int orientation, int move) { return FRAMES.faceMoves[orientation][move]; }
\ No newline at end of file
@@ -0,0 +1,125 @@
+#ifndef FACELET_MOVES_H
+#define FACELET_MOVES_H
+
+#include <string>
+using namespace std;
+
+class FaceletMoves {
+public:
+    static const int NUM_FACELETS = 54;
+    static const int NUM_LETTERS = 9;
+    static const int NUM_MOVES = NUM_LETTERS * 3;
+    static const int NUM_FACE_MOVES = 18;
+    static const int NUM_ORIENTATIONS = 24;
+    static const string MOVE_LETTERS;
+
+    /**
+     * Gets the index of a move in the permutation tables.
+     * Faces are ordered like Cube::Faces (U, L, F, R, B, D), followed by the x, y, and z rotations.
+     * @param letter A letter representing a valid move.
+     * @param turns The number of clockwise quarter turns (1, 2, or 3).
+     * @return The index of the move, -1 if the letter is invalid.
+     */
+    static int getMove(char letter, int turns);
+
+    /**
+     * Gets the letter of a move.
+     * @param move The index of the move.
+     * @return The letter of the move.
+     */
+    static char getLetter(int move);
+
+    /**
+     * Gets the number of clockwise quarter turns of a move.
+     * @param move The index of the move.
+     * @return The number of quarter turns (1, 2, or 3).
+     */
+    static int getTurns(int move);
+
+    /**
+     * Gets the move that cancels out a given move.
+     * @param move The index of the move.
+     * @return The index of the inverse move.
+     */
+    static int getInverse(int move);
+
+    /**
+     * Checks if a face turn can follow another face turn in a search without being redundant.
+     * Turning the same face twice is never needed, and opposite faces only need to be turned in one order.
+     * @param move The face turn to check.
+     * @param previous The previous face turn, -1 if there is none.
+     * @return Whether or not the move is needed.
+     */
+    static bool checkFollows(int move, int previous);
+
+    /**
+     * Gets the facelet permutation of a move, where facelet i receives the facelet at permutation[i].
+     * Facelets are indexed by face * 9 + row * 3 + col.
+     * @param move The index of the move.
+     * @return A pointer to 54 facelet indices.
+     */
+    static const unsigned char* getPermutation(int move);
+
+    /**
+     * Gets the permutation of a move padded to 64 entries, for facelets packed by FaceletKernel.
+     * The padding entries map to themselves.
+     * @param move The index of the move.
+     * @return A pointer to 64 facelet indices, aligned to 64 bytes.
+     */
+    static const unsigned char* getPackedPermutation(int move);
+
+    /**
+     * Applies a move to a flat array of facelets without allocating.
+     * @param facelets The 54 facelets to permute.
+     * @param move The index of the move.
+     */
+    static void apply(char* facelets, int move);
+
+    /**
+     * Applies a facelet permutation to a flat array of facelets without allocating.
+     * @param facelets The 54 facelets to permute.
+     * @param permutation The permutation to apply.
+     */
+    static void applyPermutation(char* facelets, const unsigned char* permutation);
+
+    /**
+     * Gets the facelets of a whole-cube orientation, reached from orientation 0 by x, y, and z rotations.
+     * The facelet seen at i from the orientation is the facelet at frame[i] of the unrotated cube.
+     * @param orientation The index of the orientation.
+     * @return A pointer to 54 facelet indices.
+     */
+    static const unsigned char* getFrame(int orientation);
+
+    /**
+     * Gets the inverse of an orientation's frame, where the facelet at i of the unrotated cube is seen at inverse[i].
+     * @param orientation The index of the orientation.
+     * @return A pointer to 54 facelet indices.
+     */
+    static const unsigned char* getFrameInverse(int orientation);
+
+    /**
+     * Gets the orientation reached by applying a rotation to another orientation.
+     * @param orientation The index of the orientation.
+     * @param move The index of an x, y, or z rotation.
+     * @return The index of the rotated orientation.
+     */
+    static int rotate(int orientation, int move);
+
+    /**
+     * Gets the orientation reached by applying the rotations that lead to one orientation after another orientation.
+     * @param orientation The index of the starting orientation.
+     * @param rotation The index of the orientation whose rotations are applied.
+     * @return The index of the combined orientation.
+     */
+    static int combine(int orientation, int rotation);
+
+    /**
+     * Gets the face turn of the unrotated cube that performs a face turn as seen from an orientation.
+     * @param orientation The index of the orientation.
+     * @param move The index of a face turn.
+     * @return The index of the same number of turns of the face seen as the move's face.
+     */
+    static int getFrameMove(int orientation, int move);
+};
+
+#endif
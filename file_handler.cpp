@@ -1,5 +1,8 @@
 #include "file_handler.h"
 #include "cube.h"
+#include "binary_store.h"
+#include "record_reader.h"
+#include "move_parser.h"
 #include <iostream>
 #include <iomanip>
 #include <string>
@@ -7,13 +10,27 @@
 #include <sstream>
 #include <vector>
 #include <set>
+#include <algorithm>
+#include <functional>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 using namespace std;
 
+const string FileHandler::JOURNAL_SUFFIX = ".journal";
+const string FileHandler::TEMP_SUFFIX = ".tmp";
+
 FileHandler::FileHandler() {
     file = "";
+    errorLine = 0;
+    errorInJournal = false;
+    journalRecords = 0;
+    binary = false;
+    cached = false;
 }
 
-FileHandler::FileHandler(const string& file) {
+FileHandler::FileHandler(const string& file) : FileHandler() {
     this->file = file;
 }
 
@@ -21,86 +38,178 @@ string FileHandler::getFileName() const { return file; }
 
 void FileHandler::setFileName(const string& file) { this->file = file; }
 
-int FileHandler::checkValidFile(bool acceptEmpty) const {
-    ifstream ifs(file);
+int FileHandler::checkValidFile(bool acceptEmpty) {
+    int status = loadFile();
+
+    if (status == CANT_OPEN) {
+        return CANT_OPEN;
+    } else if (acceptEmpty) { // File is expected to be empty
+        return (status == NO_DATA) ? VALID : BAD_FORMAT;
+    } else {
+        return status;
+    }
+}
+
+int FileHandler::getErrorLine() const { return errorLine; }
+
+string FileHandler::getErrorFile() const { return errorInJournal ? getJournalName() : file; }
+
+string FileHandler::getJournalName() const { return file + JOURNAL_SUFFIX; }
+
+map<string, long long, less<>> FileHandler::indexJournal(const string& file) {
+    map<string, long long, less<>> journal;
+    RecordReader reader(file + JOURNAL_SUFFIX);
+    RecordView record;
+
+    // Later records of a name overwrite its line, so only the newest is kept.
+    while (reader.isOpen() && reader.next(record) && record.terminated) {
+        if (!record.checkBlank()) {
+            journal[string(record.name)] = record.lineNumber;
+        }
+    }
+
+    return journal;
+}
+
+bool FileHandler::checkNewest(const map<string, long long, less<>>& journal, const RecordView& record) {
+    auto it = journal.find(record.name);
+    return it != journal.end() && it->second == record.lineNumber;
+}
+
+int FileHandler::loadFile() {
+    // Reuse the last load if neither the file nor its journal has changed since.
+    FileStamp stamp = getStamp(file);
+    FileStamp journalStamp = getStamp(getJournalName());
+    if (stamp.exists && cached && cachedFile == file && stamp == cachedStamp && journalStamp == cachedJournalStamp) {
+        return cachedStatus;
+    }
+
+    cached = false;
+    savedCubes.clear();
+    store.unload();
+    errorLine = 0;
+    errorInJournal = false;
+    journalRecords = 0;
+
+    RecordReader reader(file);
     
     // First check if unable to open file.
-    if (!ifs.is_open()) {
+    if (!reader.isOpen()) {
         return CANT_OPEN;
     }
 
-    // Check if the file is empty, if it should be considered valid.
-    char ch;
-    ifs >> ch;
+    // Records of the file must have unique names, while each record of the journal replaces the last with its name.
+    bool foundData = false;
+    int records = 0;
+    int status;
+    binary = BinaryStore::checkFormat(file);
 
-    if (ifs.eof() && acceptEmpty) {
-        return VALID;
-    } else if (ifs.eof() && !acceptEmpty) { // File is not supposed to be empty
-        return NO_DATA;
-    } else if (!ifs.eof() && acceptEmpty) { // File is expected to be empty
-        return BAD_FORMAT;
+    if (binary) { // The store is mapped and only read when its Cubes are loaded
+        status = store.load(file) ? VALID : BAD_FORMAT;
+        foundData = store.getCount() > 0;
     } else {
-        ifs.unget(); // Prepare for checking valid CSV
-    }
-
-    // Checks for valid CSVs (name, scramble, moves, and total moves).
-    set<string> uniqueNames;
-    string line;
-
-    while (getline(ifs, line)) {
-        istringstream iss(line);
-        
-        // Get name.
-        string name = "";
-        processLine(iss, name, true);
-
-        // Get scramble.
-        string scramble = "";
-        processLine(iss, scramble, false);
-
-        // Get applied moves.
-        string moves = "";
-        processLine(iss, moves, false);
-
-        // Get number of total moves (must match the count of applied moves).
-        int totalMoves;
-        iss >> totalMoves;
-
-        // If stream fails or the other conditions are invalid, the file is invalid.
-        if (!iss) {
-            return BAD_FORMAT;
-        } else if (uniqueNames.count(name) == 1) {
-            return DUPLICATE_NAMES;
-        } else if (!Cube::checkMoves(scramble) || !Cube::checkMoves(moves)) {
-            return INVALID_MOVES;
-        } else { // Check if the applied moves (now valid) and given total moves match
-            if (Cube::countMoves(moves) != totalMoves) {
-                return MISMATCHED_MOVES;
-            }
-        }
+        status = readRecords(reader, false, foundData, records);
+    }
 
-        uniqueNames.insert(name);
+    RecordReader journalReader(getJournalName());
+    if (status == VALID && journalReader.isOpen()) {
+        status = readRecords(journalReader, true, foundData, journalRecords);
+        errorInJournal = status != VALID;
     }
-    
-    return VALID;
+
+    if (status != VALID) {
+        savedCubes.clear();
+        store.unload();
+    } else if (!foundData) {
+        status = NO_DATA;
+    }
+
+    updateCache(status);
+    return status;
 }
 
-void FileHandler::processLine(istringstream& iss, string& str, bool processSpaces) const {
-    char ch;
+int FileHandler::readRecords(RecordReader& reader, bool isJournal, bool& foundData, int& records) {
+    // Validate each line (name, scramble, moves, and total moves) in a single pass, storing only where it is.
+    RecordView record;
 
-    while (iss.get(ch)) {
-        if (ch == ',') { // Don't process comma
+    while (reader.next(record)) {
+        // A journal line without a newline was cut off while being appended, so it was never saved.
+        if (isJournal && !record.terminated) {
             break;
         }
-        
-        if (!processSpaces) {
-            if (ch != ' ') {
-                str += ch;
-            }
+
+        // Leading blank lines are skipped, so that a file of whitespace counts as empty.
+        if (!foundData && record.checkBlank()) {
+            continue;
+        }
+
+        foundData = true;
+        string name(record.name);
+        int status = VALID;
+
+        // If the fields can't be read or the other conditions are invalid, the file is invalid.
+        if (!record.valid) {
+            status = BAD_FORMAT;
+        } else if (!isJournal && savedCubes.count(name) == 1) {
+            status = DUPLICATE_NAMES;
         } else {
-            str += ch;
+            // Validate and count each sequence in a single pass.
+            int movesCount = MoveParser::parse(record.moves, nullptr);
+            if (MoveParser::parse(record.scramble, nullptr) == -1 || movesCount == -1) {
+                status = INVALID_MOVES;
+            } else if (movesCount != record.totalMoves) { // Check if the applied moves (now valid) and given total moves match
+                status = MISMATCHED_MOVES;
+            }
+        }
+
+        if (status != VALID) {
+            errorLine = record.lineNumber;
+            return status;
         }
+
+        // The Cube is built when it is loaded, so listing the records never replays their moves.
+        savedCubes[name] = { isJournal, record.offset, record.totalMoves };
+        records++;
+    }
+
+    return VALID;
+}
+
+void FileHandler::updateCache(int status) {
+    cachedStamp = getStamp(file);
+    cachedJournalStamp = getStamp(getJournalName());
+    cached = cachedStamp.exists;
+    cachedFile = file;
+    cachedStatus = status;
+}
+
+FileHandler::FileStamp FileHandler::getStamp(const string& fileName) {
+    struct stat info;
+    FileStamp stamp = { false, 0, 0, 0 };
+
+    if (stat(fileName.c_str(), &info) == 0) {
+        stamp = { true, info.st_size, info.st_mtim.tv_sec, info.st_mtim.tv_nsec };
     }
+
+    return stamp;
+}
+
+bool FileHandler::FileStamp::operator==(const FileStamp& rhs) const {
+    return exists == rhs.exists && size == rhs.size && seconds == rhs.seconds && nanoseconds == rhs.nanoseconds;
+}
+
+bool FileHandler::parseRecord(const string& line, string& name, string& scramble, string& moves, int& totalMoves, string& snapshot) const {
+    RecordView record;
+    RecordReader::parse(line, record);
+
+    // Spaces are kept in names, but not in moves or snapshots.
+    name = string(record.name);
+    scramble = RecordReader::removeSpaces(record.scramble);
+    moves = RecordReader::removeSpaces(record.moves);
+    snapshot = RecordReader::removeSpaces(record.snapshot);
+    totalMoves = record.valid ? record.totalMoves : 0;
+
+    return record.valid;
 }
 
 void FileHandler::displayError(int status) const {
@@ -126,51 +235,14 @@ void FileHandler::displayError(int status) const {
         default:
             cout << "\nFile is invalid.\n";
     }
-}
-
-bool FileHandler::processValidFile() {
-    if (checkValidFile(false) != VALID) {
-        return false;
-    }
-
-    vector<string> cubeNames;
-    vector<string> cubeScrambles;
-    vector<string> cubeMoves;
-    vector<int> cubeTotalMoves;
-    ifstream ifs(file);
-    string line;
-
-    while (getline(ifs,line)) {
-        istringstream iss(line);
-        
-        // Get name.
-        string name = "";
-        processLine(iss, name, true);
-        cubeNames.push_back(name);
-
-        // Get scramble.
-        string scramble = "";
-        processLine(iss, scramble, false);
-        cubeScrambles.push_back(scramble);
-
-        // Get applied moves.
-        string moves = "";
-        processLine(iss, moves, false);
-        cubeMoves.push_back(moves);
-
-        // Get number of total moves.
-        int totalMoves;
-        iss >> totalMoves;
-        cubeTotalMoves.push_back(totalMoves);
-    }
 
-    for (int i = 0; i < cubeNames.size(); i++) {
-        string name = cubeNames[i];
-        Cube cube(name, cubeScrambles[i], cubeMoves[i], cubeTotalMoves[i]);
-        savedCubes[name] = cube;
+    if (errorLine > 0) {
+        cout << "The first error is on line " << errorLine << " of \"" << getErrorFile() << "\".\n";
     }
+}
 
-    return true;
+bool FileHandler::processValidFile() {
+    return loadFile() == VALID;
 }
 
 void FileHandler::displaySavedCubes() const {
@@ -180,9 +252,9 @@ void FileHandler::displaySavedCubes() const {
     displayTableRow("Name", "Move Count", COLUMN_WIDTH);
     cout << string(2 * COLUMN_WIDTH + 1, '-') << endl;
 
-    for (const auto& pair : savedCubes) {
-        displayTableRow(pair.first, to_string(pair.second.getTotalMoves()), COLUMN_WIDTH);
-    }
+    forEachSavedCube([&](const string& name, const Record* record, int index) {
+        displayTableRow(name, to_string(record != nullptr ? record->totalMoves : store.getTotalMoves(index)), COLUMN_WIDTH);
+    });
     
     cout << string(2 * COLUMN_WIDTH + 1, '-') << endl << endl;
 }
@@ -194,16 +266,73 @@ void FileHandler::displayTableRow(const string& first, const string& second, int
 bool FileHandler::loadCube(Cube& cube, const string& name) {
     if (!processValidFile()) { return false; }
 
+    // The journal holds the newest record of a name, so it is checked before the store.
     if (savedCubes.count(name) == 1) {
-        cube = savedCubes.at(name);
-        return true;
-    } else {
+        const Record& record = savedCubes.at(name);
+        ifstream ifs(record.inJournal ? getJournalName() : file);
+        return readCube(record, ifs, cube);
+    }
+
+    int index = store.find(name);
+    return index != -1 && store.readCube(index, cube);
+}
+
+bool FileHandler::readCube(const Record& record, istream& is, Cube& cube) const {
+    // The record was validated when the file was loaded, so it only needs to be split and built.
+    string line, name, scramble, moves, snapshot;
+    int totalMoves;
+
+    is.clear();
+    is.seekg(record.offset);
+    if (!getline(is, line) || !parseRecord(line, name, scramble, moves, totalMoves, snapshot)) {
         return false;
     }
+
+    // The moves are only replayed if the record has no intact snapshot.
+    cube = Cube(name, scramble, moves, totalMoves, snapshot);
+    return true;
+}
+
+void FileHandler::forEachSavedCube(const function<void(const string&, const Record*, int)>& visit) const {
+    // Both the records and the store are sorted by name, so they are merged like two sorted lists.
+    auto it = savedCubes.begin();
+    int index = 0;
+
+    while (it != savedCubes.end() || index < store.getCount()) {
+        string storedName = (index < store.getCount()) ? string(store.getName(index)) : "";
+
+        if (it != savedCubes.end() && (index == store.getCount() || it->first <= storedName)) {
+            if (index < store.getCount() && it->first == storedName) { // The journal replaces the stored Cube
+                index++;
+            }
+
+            visit(it->first, &it->second, -1);
+            it++;
+        } else {
+            visit(storedName, nullptr, index);
+            index++;
+        }
+    }
+}
+
+vector<string> FileHandler::verifySavedCubes() const {
+    vector<string> mismatched;
+    ifstream ifs(file);
+    ifstream jfs(getJournalName());
+    Cube cube;
+
+    forEachSavedCube([&](const string& name, const Record* record, int index) {
+        bool read = (record != nullptr) ? readCube(*record, record->inJournal ? jfs : ifs, cube) : store.readCube(index, cube);
+        if (!read || !cube.checkReplay()) {
+            mismatched.push_back(name);
+        }
+    });
+
+    return mismatched;
 }
 
 bool FileHandler::checkTaken(const string& name) const {
-    if (savedCubes.count(name) == 1) {
+    if (savedCubes.count(name) == 1 || store.find(name) != -1) {
         return true;
     }
 
@@ -211,36 +340,174 @@ bool FileHandler::checkTaken(const string& name) const {
 }
 
 bool FileHandler::saveCubeToFile(const Cube& cube) {
-    // First check if the file is empty.
+    // First check if the file is empty, which also loads it if it contains values.
     bool isEmpty = checkValidFile(true) == VALID;
+    if (!isEmpty && loadFile() != VALID) { return false; }
 
-    // Try processing the file if the file contains values.
-    if (!isEmpty && !processValidFile()) { return false; }
+    // Append the record to the journal, where it replaces any older record with the same name.
+    string line = convertCubeData(cube);
+    streamoff offset = trimJournal();
+    if (offset == -1) { return false; }
 
-    // Try opening the file.
-    ofstream ofs(file);
+    ofstream ofs(getJournalName(), ios::app);
     if (!ofs.is_open()) { return false; }
 
-    // If the file has valid values, update the cube data and push the entries.
-    // Otherwise, simply put the given cube data into the file.
-    if (!isEmpty) {
-        savedCubes[cube.getName()] = cube;
-        
-        for (const auto& pair : savedCubes) {
-            convertCubeData(ofs, pair.second);
+    ofs << line;
+    ofs.close();
+    if (ofs.fail()) { return false; }
+
+    // Store where the record was written, so the next load does not need to reparse the file.
+    string name, scramble, moves, snapshot;
+    int totalMoves;
+    parseRecord(line, name, scramble, moves, totalMoves, snapshot);
+    savedCubes[name] = { true, offset, totalMoves };
+    journalRecords++;
+    updateCache(VALID);
+
+    // Folding the journal in once it is as long as the file keeps both the journal and the time to compact bounded.
+    if (journalRecords >= max((int) COMPACT_MIN_RECORDS, (int) savedCubes.size() + store.getCount())) {
+        return compact();
+    }
+
+    return true;
+}
+
+bool FileHandler::syncFile(const string& fileName, bool directory) {
+    string name = fileName;
+    if (directory) {
+        size_t slash = fileName.rfind('/');
+        name = (slash == string::npos) ? "." : (slash == 0) ? "/" : fileName.substr(0, slash);
+    }
+
+    int fd = open(name.c_str(), O_RDONLY);
+    if (fd == -1) { return false; }
+
+    bool synced = fsync(fd) == 0;
+    close(fd);
+    return synced;
+}
+
+streamoff FileHandler::trimJournal() const {
+    FileStamp stamp = getStamp(getJournalName());
+    if (!stamp.exists) { return 0; }
+
+    // Search back from the end for the newline of the last complete record.
+    const int CHUNK_SIZE = 4096;
+    ifstream ifs(getJournalName(), ios::binary);
+    char chunk[CHUNK_SIZE];
+    streamoff end = stamp.size;
+
+    while (end > 0) {
+        int count = (int) min((streamoff) CHUNK_SIZE, end);
+        if (!ifs.seekg(end - count) || !ifs.read(chunk, count)) { return -1; }
+
+        int i = count - 1;
+        while (i >= 0 && chunk[i] != '\n') {
+            i--;
         }
-    } else {
-        convertCubeData(ofs, cube);
+
+        if (i >= 0) {
+            end -= count - i - 1;
+            break;
+        }
+
+        end -= count;
     }
-    
+
+    if (end != stamp.size && truncate(getJournalName().c_str(), end) != 0) {
+        return -1;
+    }
+
+    return end;
+}
+
+bool FileHandler::compact() {
+    int status = loadFile();
+    if (status != VALID && status != NO_DATA) { return false; }
+
+    // Write every current record to a temporary file in the same format, which replaces the file at once,
+    // so a crash leaves either version. The data is on the disk before the rename, or a power loss could leave an empty file.
+    string tempName = file + TEMP_SUFFIX;
+    if (!writeSavedCubes(tempName, binary) || !syncFile(tempName, false) || rename(tempName.c_str(), file.c_str()) != 0) {
+        remove(tempName.c_str());
+        return false;
+    }
+
+    // Replaying the journal over the new file would not change anything, so it is safe to remove it last,
+    // once the rename is on the disk. If that cannot be confirmed, the journal is kept and still replays correctly.
+    if (!syncFile(file, true)) {
+        cached = false;
+        return false;
+    }
+
+    // The stored records point into the old files, so the next access loads the new one.
+    remove(getJournalName().c_str());
+    journalRecords = 0;
+    cached = false;
     return true;
 }
 
-void FileHandler::convertCubeData(ofstream& ofs, const Cube& cube) const {
-    ofs << cube.getName() << ", " + cube.getScramble() << ", " << cube.getMoves() << cube.getCurrentMoves() << ", " << cube.getTotalMoves() << endl;
+bool FileHandler::convert(const string& outputFile, bool binaryOutput) {
+    int status = loadFile();
+    if (status != VALID && status != NO_DATA) { return false; }
+
+    // The output may be the mapped file itself, so it is only replaced once it has been written and flushed.
+    string tempName = outputFile + TEMP_SUFFIX;
+    if (!writeSavedCubes(tempName, binaryOutput) || !syncFile(tempName, false) || rename(tempName.c_str(), outputFile.c_str()) != 0) {
+        remove(tempName.c_str());
+        return false;
+    }
+
+    cached = false;
+    return syncFile(outputFile, true);
+}
+
+bool FileHandler::checkBinary() const { return binary; }
+
+bool FileHandler::writeSavedCubes(const string& fileName, bool binaryOutput) const {
+    ofstream ofs;
+    if (!binaryOutput) {
+        ofs.open(fileName);
+        if (!ofs.is_open()) { return false; }
+    }
+
+    ifstream ifs(file);
+    ifstream jfs(getJournalName());
+    BinaryStore::Builder builder;
+    Cube cube;
+    bool written = true;
+
+    forEachSavedCube([&](const string&, const Record* record, int index) {
+        if (!written) { return; }
+
+        written = (record != nullptr) ? readCube(*record, record->inJournal ? jfs : ifs, cube) : store.readCube(index, cube);
+        if (written && binaryOutput) {
+            written = builder.add(cube);
+        } else if (written) {
+            ofs << convertCubeData(cube);
+        }
+    });
+
+    if (binaryOutput) {
+        return written && builder.write(fileName);
+    }
+
+    ofs.close();
+    return written && !ofs.fail();
+}
+
+string FileHandler::convertCubeData(const Cube& cube) const {
+    return cube.getName() + ", " + cube.getScramble() + ", " + cube.getMoves() + cube.getCurrentMoves() + ", " + to_string(cube.getTotalMoves())
+        + ", " + cube.getSnapshot() + "\n";
 }
 
 void FileHandler::reset() {
     file = "";
     savedCubes.clear();
+    store.unload();
+    binary = false;
+    errorLine = 0;
+    errorInJournal = false;
+    journalRecords = 0;
+    cached = false;
 }
\ No newline at end of file
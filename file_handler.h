@@ -1,16 +1,26 @@
-#ifndef FILE_HANLDER_H
+#ifndef FILE_HANDLER_H
 #define FILE_HANDLER_H
 
 #include "cube.h"
+#include "binary_store.h"
+#include "record_reader.h"
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <map>
+#include <vector>
+#include <ctime>
+#include <istream>
+#include <functional>
+#include <sys/types.h>
 using namespace std;
 
 class FileHandler {
 public:
 	enum VALID_STATUS { VALID, CANT_OPEN, NO_DATA, BAD_FORMAT, DUPLICATE_NAMES, INVALID_MOVES, MISMATCHED_MOVES };
+	static const string JOURNAL_SUFFIX; // Appended to the file name for the journal of saves
+	static const string TEMP_SUFFIX;    // Appended to the file name while compacting
+	static const int COMPACT_MIN_RECORDS = 32;
 
 	/**
 	 * Default constructor for FileHandler.
@@ -36,11 +46,71 @@ public:
 	void setFileName(const string& file);
 	
 	/**
-	 * Checks if the given file is valid (CSV of unique names, scramble, moves, and total moves).
+	 * Checks if the given file is valid (CSV of unique names, scramble, moves, and total moves, or a BinaryStore), loading it if so.
 	 * @param acceptEmpty Whether or not empty files should be considered valid.
 	 * @return An integer representing whether or not the file is valid.
 	 */
-	int checkValidFile(bool acceptEmpty) const;
+	int checkValidFile(bool acceptEmpty);
+
+	/**
+	 * Reads, validates, and stores where every record of the file and then its journal is in a single pass.
+	 * A file that starts with the header of a BinaryStore is mapped instead, and its journal is still CSV.
+	 * Cubes are only built from their records when they are loaded, and the result is cached until the size or modification time of either file changes.
+	 * @return An integer representing whether or not the file is valid (NO_DATA if both are empty).
+	 */
+	int loadFile();
+
+	/**
+	 * Gets the line of the first error found by the last load.
+	 * @return The line number starting from 1, or 0 if there was no error in a line.
+	 */
+	int getErrorLine() const;
+
+	/**
+	 * Gets the name of the file that contains the first error found by the last load.
+	 * @return The name of the file or of its journal.
+	 */
+	string getErrorFile() const;
+
+	/**
+	 * Gets the name of the journal, where saves are appended until they are compacted into the file.
+	 * @return The name of the journal.
+	 */
+	string getJournalName() const;
+
+	/**
+	 * Finds the newest record of every name in the journal of a file, for readers that stream the file instead of loading it.
+	 * Like a load, blank lines and a last line that was cut off while being appended are skipped.
+	 * @param file The name of the file.
+	 * @return The line number of each name's newest record in the journal, which replaces every other record with its name.
+	 */
+	static map<string, long long, less<>> indexJournal(const string& file);
+
+	/**
+	 * Checks if a line of a journal is the newest record of its name, which is the one that should be read.
+	 * @param journal The index of the journal.
+	 * @param record A line of the journal.
+	 * @return Whether or not the record is used.
+	 */
+	static bool checkNewest(const map<string, long long, less<>>& journal, const RecordView& record);
+
+	/**
+	 * Splits a line of a file into the fields of a Cube (name, scramble, moves, total moves, and an optional snapshot).
+	 * @param line The line to split.
+	 * @param name The name, which will be updated.
+	 * @param scramble The scramble without spaces, which will be updated.
+	 * @param moves The applied moves without spaces, which will be updated.
+	 * @param totalMoves The number of total moves, which will be updated.
+	 * @param snapshot The snapshot of the stickers, which will be updated (empty if the line has none).
+	 * @return Whether or not every required field could be read.
+	 */
+	bool parseRecord(const string& line, string& name, string& scramble, string& moves, int& totalMoves, string& snapshot) const;
+
+	/**
+	 * Checks that every stored Cube's history replays to its stickers, which verifies the snapshots that were loaded.
+	 * @return The names of the Cubes whose snapshots do not match their moves.
+	 */
+	vector<string> verifySavedCubes() const;
 
 	/**
 	 * Displays an error message that shows up when a file is invalid.
@@ -49,7 +119,7 @@ public:
 	void displayError(int status) const;
 
 	/**
-	 * Stores all the Cube objects from a valid file.
+	 * Stores the records of a valid file, reusing the last load if the file has not changed.
 	 * @return Whether or not the process was successful.
 	 */
 	bool processValidFile();
@@ -60,7 +130,7 @@ public:
 	void displaySavedCubes() const;
 
 	/**
-	 * Sets a given Cube to a Cube mapped to a name.
+	 * Sets a given Cube to a Cube mapped to a name, reading and building it from its record.
 	 * @param cube The cube to modify.
 	 * @param name The name of the Cube.
 	 * @return Whether or not the load was successful.
@@ -75,25 +145,113 @@ public:
 	bool checkTaken(const string& name) const;
 
 	/**
-	 * Tries saving Cube data to the file.
+	 * Tries saving Cube data by appending it to the journal, compacting once the journal is as long as the file.
 	 * @param cube The Cube to save.
 	 * @return Whether or not the save was successful.
 	 */
 	bool saveCubeToFile(const Cube& cube);
 
+	/**
+	 * Rewrites the file with the newest record of every name and removes the journal.
+	 * The records are written and flushed to a temporary file that is renamed over the file, so the file is never partially written,
+	 * and the journal is only removed once the rename is on the disk, so a power loss cannot lose the records that were compacted.
+	 * @return Whether or not the compaction was successful.
+	 */
+	bool compact();
+
+	/**
+	 * Writes every stored Cube, including those in the journal, to another file, which converts a CSV file to a BinaryStore or back.
+	 * @param outputFile The name of the file to write.
+	 * @param binaryOutput Whether the file should be a BinaryStore or CSV.
+	 * @return Whether or not the file was valid and the other file was written.
+	 */
+	bool convert(const string& outputFile, bool binaryOutput);
+
+	/**
+	 * Checks if the loaded file is a BinaryStore.
+	 * @return Whether or not the file is a BinaryStore rather than CSV.
+	 */
+	bool checkBinary() const;
+
 	/**
 	 * Resets the FileHandler object.
 	 */
 	void reset();
 private:
 	/**
-	 * Processes a portion of a line until a comma is reached.
-	 * @param iss The istringstream to update.
-	 * @param str The string to update.
-	 * @param processSpaces Whether or not spaces should be processed.
-	 * return A string before the commas.
+	 * The size and modification time of a file, which change whenever it is written.
+	 */
+	struct FileStamp {
+		bool exists;
+		off_t size;
+		time_t seconds;
+		long nanoseconds;
+
+		bool operator==(const FileStamp& rhs) const;
+	};
+
+	/**
+	 * Where a record is stored, which is all that is kept of it until its Cube is loaded.
+	 */
+	struct Record {
+		bool inJournal;
+		streamoff offset;
+		int totalMoves;
+	};
+
+	/**
+	 * Reads a record and builds its Cube.
+	 * @param record The location of the record.
+	 * @param is The stream of the file or journal that contains the record.
+	 * @param cube The Cube, which will be updated.
+	 * @return Whether or not the record could still be read.
+	 */
+	bool readCube(const Record& record, istream& is, Cube& cube) const;
+
+	/**
+	 * Visits the name of every stored Cube in order, where records of the journal replace those of a BinaryStore.
+	 * @param visit Called with the name and either the record or the index of the Cube in the store (the other is null or -1).
 	 */
-	void processLine(istringstream& iss, string& str, bool processSpaces) const;
+	void forEachSavedCube(const function<void(const string&, const Record*, int)>& visit) const;
+
+	/**
+	 * Writes every stored Cube to a file.
+	 * @param fileName The name of the file to write.
+	 * @param binaryOutput Whether the file should be a BinaryStore or CSV.
+	 * @return Whether or not every Cube could be read and written.
+	 */
+	bool writeSavedCubes(const string& fileName, bool binaryOutput) const;
+
+	/**
+	 * Gets the current stamp of a file.
+	 * @param fileName The name of the file.
+	 * @return The stamp, which does not exist if the file could not be found.
+	 */
+	static FileStamp getStamp(const string& fileName);
+
+	/**
+	 * Flushes a file that has been written and closed to the disk, so it survives a power loss.
+	 * @param fileName The name of the file.
+	 * @param directory Whether the directory that holds the file should be flushed instead, which makes a rename or removal in it durable.
+	 * @return Whether or not the flush was successful.
+	 */
+	static bool syncFile(const string& fileName, bool directory);
+
+	/**
+	 * Cuts a line that was not finished being appended off the end of the journal, so the next record starts on its own line.
+	 * @return The size of the journal, where the next record starts, or -1 if it could not be trimmed.
+	 */
+	streamoff trimJournal() const;
+
+	/**
+	 * Validates and stores where each record of a file is.
+	 * @param reader The reader of the file.
+	 * @param isJournal Whether or not records replace earlier ones with the same name, and a cut off last line is ignored.
+	 * @param foundData Whether or not a record has been found, which will be updated.
+	 * @param records The number of records read, which will be updated.
+	 * @return An integer representing whether or not the records are valid.
+	 */
+	int readRecords(RecordReader& reader, bool isJournal, bool& foundData, int& records);
 
 	/**
 	 * Displays a row of a table.
@@ -104,14 +262,32 @@ private:
 	void displayTableRow(const string& first, const string& second, int width) const;
 
 	/**
-	 * Produces a line of Cube data and saves it to a file.
-	 * @param ofs The ofstream to write to.
+	 * Produces a line of Cube data to save to a file.
 	 * @param cube The Cube to process.
+	 * @return The line, ending with a newline.
 	 */
-	void convertCubeData(ofstream& ofs, const Cube& cube) const;
+	string convertCubeData(const Cube& cube) const;
+
+	/**
+	 * Remembers the stamps of the file and its journal, which the stored Cubes now match.
+	 * @param status The status of the file to return while it is unchanged.
+	 */
+	void updateCache(int status);
 
 	string file;
-	map<string, Cube> savedCubes;
+	map<string, Record> savedCubes;
+	BinaryStore store;
+	bool binary;
+	int errorLine;
+	bool errorInJournal;
+	int journalRecords;
+
+	// The file that savedCubes was loaded from, and the stamps of it and its journal at the time.
+	bool cached;
+	string cachedFile;
+	FileStamp cachedStamp;
+	FileStamp cachedJournalStamp;
+	int cachedStatus;
 };
 
 #endif
\ No newline at end of file
@@ -2,7 +2,13 @@
 #include "tester.h"
 #include "file_handler.h"
 #include "cube.h"
+#include "record_reader.h"
+#include "file_validator.h"
 #include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdio>
 using namespace std;
 
 int FileHandlerTests::runTests() const {
@@ -129,6 +135,308 @@ int FileHandlerTests::runTests() const {
         tester.test("Saving a cube to an invalid file is displayed as unsuccessful", passed);
     }
 
+    // Test that the line of the first error is reported
+    {
+        FileHandler handler("test_files/duplicate_names.txt");
+        bool passed = handler.loadFile() == FileHandler::DUPLICATE_NAMES && handler.getErrorLine() == 2;
+        tester.test("The line of the first error in a file is reported", passed);
+    }
+
+    // Test that a load is reused until the file changes
+    {
+        const string FILE_NAME = "test_files/cache_test.txt";
+        ofstream(FILE_NAME) << "Clarence Mariano, R2 U2 R', U, 1\n";
+
+        FileHandler handler(FILE_NAME);
+        bool firstLoad = handler.loadFile() == FileHandler::VALID && handler.checkTaken("Clarence Mariano");
+        bool repeatLoad = handler.processValidFile() && handler.checkTaken("Clarence Mariano");
+
+        ofstream(FILE_NAME) << "John, , R, 1\nDon, RURF, , 0\nJohn, , , 0\n"; // A different size is always detected
+        bool changedLoad = handler.loadFile() == FileHandler::DUPLICATE_NAMES && handler.getErrorLine() == 3;
+
+        tester.test("Loads are reused while the file is unchanged and redone after it changes", firstLoad && repeatLoad && changedLoad);
+        remove(FILE_NAME.c_str());
+    }
+
+    // Test that a saved cube can be loaded back
+    {
+        const string FILE_NAME = "test_files/save_test.txt";
+        ofstream(FILE_NAME) << "John, , R, 1\n";
+
+        FileHandler handler(FILE_NAME);
+        Cube cube("Don", "RURF", "", 0);
+        cube.doMoves("U2", true);
+        bool saved = handler.saveCubeToFile(cube);
+
+        FileHandler otherHandler(FILE_NAME);
+        Cube loaded1, loaded2;
+        bool passed = saved && handler.loadCube(loaded1, "Don") && otherHandler.loadCube(loaded2, "Don")
+            && loaded1 == loaded2 && handler.checkTaken("John") && loaded1.getTotalMoves() == cube.getTotalMoves();
+        tester.test("A saved cube is loaded the same way from the cache and from the file", passed);
+        remove(FILE_NAME.c_str());
+        remove(handler.getJournalName().c_str());
+    }
+
+    // Test that saves are appended to the journal, where the newest record of a name wins
+    {
+        const string FILE_NAME = "test_files/journal_test.txt";
+        ofstream(FILE_NAME) << "John, , R, 1\n";
+
+        FileHandler handler(FILE_NAME);
+        Cube cube("John", "", "R", 1);
+        cube.doMoves("U", true);
+        handler.saveCubeToFile(cube);
+        cube.doMoves("F", true);
+        handler.saveCubeToFile(cube);
+        ofstream(handler.getJournalName(), ios::app) << "John, , RUFB, 4"; // Cut off before its newline
+
+        ifstream ifs(FILE_NAME);
+        string firstLine;
+        getline(ifs, firstLine);
+
+        FileHandler otherHandler(FILE_NAME);
+        Cube loaded;
+        bool passed = firstLine == "John, , R, 1" && otherHandler.loadCube(loaded, "John") && loaded.getTotalMoves() == 3;
+        tester.test("Saves are appended without rewriting the file, and the newest complete record is loaded", passed);
+
+        // Test compacting the journal into the file
+        bool compacted = handler.compact() && !ifstream(handler.getJournalName()).is_open();
+        FileHandler compactedHandler(FILE_NAME);
+        Cube compactedCube;
+        passed = compacted && compactedHandler.loadCube(compactedCube, "John") && compactedCube.getTotalMoves() == 3;
+        tester.test("Compacting writes the newest records to the file and removes the journal", passed);
+
+        remove(FILE_NAME.c_str());
+        remove(handler.getJournalName().c_str());
+    }
+
+    // Test that a save after a cut off journal line starts on its own line
+    {
+        const string FILE_NAME = "test_files/torn_journal_test.txt";
+        ofstream(FILE_NAME) << "John, , R, 1\n";
+
+        FileHandler handler(FILE_NAME);
+        Cube cube("Don", "", "", 0);
+        cube.doMoves("U", true);
+        handler.saveCubeToFile(cube);
+        ofstream(handler.getJournalName(), ios::app) << "John, , RUFB, 4"; // Cut off before its newline
+        cube.doMoves("F", true);
+        bool saved = handler.saveCubeToFile(cube);
+
+        FileHandler otherHandler(FILE_NAME);
+        Cube loaded1, loaded2, loadedJohn;
+        bool passed = saved && otherHandler.checkValidFile(false) == FileHandler::VALID && otherHandler.loadCube(loaded1, "Don")
+            && handler.loadCube(loaded2, "Don") && loaded1 == loaded2 && loaded1.getTotalMoves() == 2
+            && otherHandler.loadCube(loadedJohn, "John") && loadedJohn.getTotalMoves() == 1;
+        tester.test("Saving after a cut off journal line drops the cut off line and keeps the new record", passed);
+
+        remove(FILE_NAME.c_str());
+        remove(handler.getJournalName().c_str());
+    }
+
+    // Test that the journal is compacted automatically
+    {
+        const string FILE_NAME = "test_files/compact_test.txt";
+        ofstream(FILE_NAME) << "John, , R, 1\n";
+
+        FileHandler handler(FILE_NAME);
+        Cube cube("Don", "", "", 0);
+        for (int i = 0; i < FileHandler::COMPACT_MIN_RECORDS; i++) {
+            cube.doMoves("U", true);
+            handler.saveCubeToFile(cube);
+        }
+
+        FileHandler otherHandler(FILE_NAME);
+        Cube loaded;
+        bool passed = !ifstream(handler.getJournalName()).is_open() && otherHandler.loadCube(loaded, "Don")
+            && loaded.getTotalMoves() == FileHandler::COMPACT_MIN_RECORDS && otherHandler.checkTaken("John");
+        tester.test("The journal is compacted into the file once it has enough records", passed);
+
+        remove(FILE_NAME.c_str());
+        remove(handler.getJournalName().c_str());
+    }
+
+    // Test that snapshots are trusted when loading and checked on demand
+    {
+        const string FILE_NAME = "test_files/snapshot_test.txt";
+        Cube scrambled("John", "", "R", 1);
+        string snapshot = scrambled.getSnapshot();
+        string damaged = snapshot;
+        damaged[0] = 'Y';
+
+        // The first record's snapshot does not match its moves, but its checksum is intact.
+        ofstream(FILE_NAME) << "John, , , 0, " << snapshot << "\nDon, , R, 1, " << damaged << "\n";
+
+        FileHandler handler(FILE_NAME);
+        Cube john, don;
+        bool loaded = handler.loadCube(john, "John") && handler.loadCube(don, "Don");
+        vector<string> mismatched = handler.verifySavedCubes();
+        bool passed = loaded && john.getSnapshot() == snapshot && !john.checkReplay() && don.getSnapshot() == snapshot
+            && mismatched.size() == 1 && mismatched[0] == "John";
+        tester.test("Intact snapshots are loaded without replaying, and damaged ones are replayed", passed);
+        remove(FILE_NAME.c_str());
+    }
+
+    // Test that records are listed without building their cubes and read from their offsets when loaded
+    {
+        const string FILE_NAME = "test_files/lazy_test.txt";
+        ofstream(FILE_NAME) << "John, , R, 1\nDon, RURF, U2, 2\n";
+
+        FileHandler handler(FILE_NAME);
+        Cube cube("Ann", "", "F", 1);
+        bool passed = handler.processValidFile() && handler.checkTaken("Don") && handler.saveCubeToFile(cube);
+
+        Cube john, don, ann;
+        passed = passed && handler.loadCube(john, "John") && handler.loadCube(don, "Don") && handler.loadCube(ann, "Ann")
+            && john.getMoves() == "R" && don.getScramble() == "RURF" && don.getTotalMoves() == 2
+            && ann.getSnapshot() == cube.getSnapshot() && !handler.loadCube(cube, "Bob");
+        tester.test("Cubes are built from their records in the file and journal only when they are loaded", passed);
+        remove(FILE_NAME.c_str());
+        remove(handler.getJournalName().c_str());
+    }
+
+    // Test converting to and from the binary format
+    {
+        const string FILE_NAME = "test_files/convert_test.txt";
+        const string BINARY_NAME = "test_files/convert_test.bin";
+        ofstream(FILE_NAME) << "John, , R, 1\nDon, RURF, U'2x, 3\nAnn, F2, , 0\n";
+
+        FileHandler handler(FILE_NAME);
+        bool passed = handler.convert(BINARY_NAME, true) && !handler.checkBinary();
+
+        FileHandler binaryHandler(BINARY_NAME);
+        Cube john, don, csvDon;
+        passed = passed && binaryHandler.processValidFile() && binaryHandler.checkBinary() && binaryHandler.checkTaken("Ann")
+            && !binaryHandler.checkTaken("Bob") && binaryHandler.loadCube(john, "John") && binaryHandler.loadCube(don, "Don")
+            && handler.loadCube(csvDon, "Don") && john.getMoves() == "R" && don.getScramble() == "RURF" && don.getMoves() == "U'2x"
+            && don.getTotalMoves() == 3 && don.getSnapshot() == csvDon.getSnapshot() && binaryHandler.verifySavedCubes().empty();
+        tester.test("A converted binary store finds and builds the same cubes as the CSV file", passed);
+
+        Cube bob("Bob", "", "L", 1);
+        john.doMoves("D", true);
+        passed = binaryHandler.saveCubeToFile(bob) && binaryHandler.saveCubeToFile(john) && binaryHandler.loadCube(john, "John")
+            && binaryHandler.checkTaken("Bob") && john.getMoves() == "RD";
+        passed = passed && binaryHandler.compact() && binaryHandler.loadFile() == FileHandler::VALID && binaryHandler.checkBinary()
+            && binaryHandler.loadCube(john, "John") && john.getMoves() == "RD" && binaryHandler.loadCube(bob, "Bob");
+        tester.test("Saves to a binary store are journaled and compacted into a new binary store", passed);
+
+        passed = binaryHandler.convert(FILE_NAME, false) && handler.loadFile() == FileHandler::VALID && !handler.checkBinary()
+            && handler.loadCube(john, "John") && john.getMoves() == "RD" && handler.checkTaken("Bob");
+        ofstream(BINARY_NAME, ios::in | ios::out) << "RCASTO01 damaged";
+        passed = passed && binaryHandler.loadFile() == FileHandler::BAD_FORMAT;
+        tester.test("A binary store converts back to CSV, and a damaged header is rejected", passed);
+        remove(FILE_NAME.c_str());
+        remove(BINARY_NAME.c_str());
+        remove(binaryHandler.getJournalName().c_str());
+    }
+
+    // Test reading records one line at a time
+    {
+        const string FILE_NAME = "test_files/reader_test.txt";
+        string longName(100, 'a');
+        string contents = "John, , R U, 2\n\n" + longName + ", RURF, , 0, snapshot\nDon, , , x\nAnn, F, , 0";
+        ofstream(FILE_NAME) << contents;
+
+        // A buffer smaller than a line must grow to fit it and keep the lines after it intact.
+        // The views of each record are only valid until the next line, so the lines are copied.
+        RecordReader reader(FILE_NAME, 8);
+        vector<RecordView> records;
+        vector<string> lines;
+        RecordView record;
+        while (reader.next(record)) {
+            records.push_back(record);
+            lines.emplace_back(record.line);
+        }
+
+        bool passed = reader.isOpen() && records.size() == 5 && lines[0] == "John, , R U, 2" && records[0].totalMoves == 2
+            && records[0].valid && lines[1].empty() && lines[2].substr(0, 100) == longName && records[2].offset == 16
+            && records[2].valid && records[3].lineNumber == 4 && !records[3].valid && records[4].valid && !records[4].terminated
+            && records[3].terminated && contents.substr(records[4].offset) == "Ann, F, , 0";
+        tester.test("Lines are read in order through a small buffer, with their offsets and line numbers", passed);
+
+        RecordView fields;
+        passed = RecordReader::parse(lines[2], fields) && fields.name == longName && fields.scramble == " RURF"
+            && fields.snapshot == " snapshot" && RecordReader::removeSpaces(fields.scramble) == "RURF"
+            && !RecordReader::parse("John, , R", fields) && !RecordReader::parse("John, , R, 99999999999", fields);
+        tester.test("Lines are split into views of their fields", passed);
+        remove(FILE_NAME.c_str());
+    }
+
+    // Test that parallel validation finds the same first error as loading
+    {
+        const string FILE_NAME = "test_files/validator_test.txt";
+        const vector<string> CONTENTS = {
+            "John, , R, 1\nDon, RURF, U2, 2\nAnn, F, , 0\n",
+            "\n  \n\nJohn, , R, 1\nDon, RURF, U2, 2",
+            "John, , R, 1\nDon, RURF, U2, 2\n\nAnn, F, , 0\n",
+            "John, , R, 1\nDon, RURF, U2, 2\nAnn, F, , 0\nBob, , , 0\nJohn, , , 0\n",
+            "John, , R, 1\nDon, RURF, Q, 1\nAnn, F, , 0\nJohn, , , 0\n",
+            "John, , R, 1\nDon, RURF, U2, 2\nJohn, , Q, 1\n",
+            "John, , R, 1\nDon, RURF, U2, 3\n",
+            "John, , R, 1\nDon, RURF\n",
+            " \n\t\n",
+            ""
+        };
+
+        bool passed = true;
+        for (const string& contents : CONTENTS) {
+            ofstream(FILE_NAME) << contents;
+            FileHandler handler(FILE_NAME);
+            FileValidator validator(4, 8); // Small chunks split every file between threads
+
+            int status = handler.loadFile();
+            passed = passed && validator.validate(FILE_NAME) == status && validator.getErrorLine() == handler.getErrorLine();
+        }
+
+        tester.test("Validating in chunks finds the same status and line as loading the file", passed);
+
+        ofstream(FILE_NAME) << CONTENTS[0];
+        FileValidator validator(2);
+        passed = validator.validate(FILE_NAME) == FileHandler::VALID && validator.getRecords() == 3 && validator.getThreads() == 2
+            && validator.validate("test_files/missing.txt") == FileHandler::CANT_OPEN;
+        tester.test("Valid files report their number of records", passed);
+
+        // Test that the journal is validated after the file, with the rules of a load
+        const vector<pair<string, string>> JOURNALS = {
+            { "John, , R, 1\n", "Ann, F, , 0\nJohn, , RU, 2\nJohn, , RUF, 3\n" },
+            { "John, , R, 1\n", "Ann, F, , 0\nJohn, , RU, 3\n" },
+            { "John, , R, 1\n", "\nAnn, F, , 0\n" },
+            { "\n", "\nAnn, F, , 0\n\n" },
+            { "", "Ann, F, Q, 1\n" },
+            { "John, , R, 1\n", "Ann, F, , 0\nBob, , Q, 1" },
+            { "John, , Q, 1\n", "Ann, F, Q, 1\n" },
+            { " \n", "  \n" }
+        };
+
+        passed = true;
+        for (const pair<string, string>& files : JOURNALS) {
+            ofstream(FILE_NAME) << files.first;
+            ofstream(FILE_NAME + FileHandler::JOURNAL_SUFFIX) << files.second;
+            FileHandler handler(FILE_NAME);
+            FileValidator validator(4, 8);
+
+            int status = handler.loadFile();
+            passed = passed && validator.validate(FILE_NAME) == status && validator.getErrorLine() == handler.getErrorLine()
+                && (status == FileHandler::VALID || status == FileHandler::NO_DATA || validator.getErrorFile() == handler.getErrorFile());
+        }
+
+        tester.test("Validating a file and its journal finds the same status, line, and file as loading them", passed);
+
+        // Test that saves that were not compacted are counted
+        ofstream(FILE_NAME) << CONTENTS[0];
+        remove((FILE_NAME + FileHandler::JOURNAL_SUFFIX).c_str());
+        FileHandler handler(FILE_NAME);
+        Cube john("John", "", "R", 1);
+        Cube bob("Bob", "", "", 0);
+        john.doMoves("U", true);
+        passed = handler.saveCubeToFile(john) && handler.saveCubeToFile(bob) && validator.validate(FILE_NAME) == FileHandler::VALID
+            && validator.getRecords() == 4;
+        tester.test("Cubes saved to the journal are validated and counted once", passed);
+
+        remove(FILE_NAME.c_str());
+        remove(handler.getJournalName().c_str());
+    }
+
     return tester.finishTests();
 }
 
@@ -0,0 +1,297 @@
+#include "file_validator.h"
+#include "file_handler.h"
+#include "binary_store.h"
+#include "record_reader.h"
+#include "move_parser.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+using namespace std;
+
+namespace {
+    /**
+     * Runs a task for every index on a pool of threads, where each thread takes the next index that has not been run.
+     * @param numThreads The number of threads.
+     * @param count The number of indices.
+     * @param task The task, called with each index.
+     */
+    void runTasks(int numThreads, int count, const function<void(int)>& task) {
+        atomic<int> next(0);
+        vector<thread> threads;
+
+        auto work = [&]() {
+            for (int i = next++; i < count; i = next++) {
+                task(i);
+            }
+        };
+
+        for (int t = 1; t < min(numThreads, count); t++) {
+            threads.emplace_back(work);
+        }
+
+        work();
+        for (thread& t : threads) {
+            t.join();
+        }
+    }
+
+    /**
+     * Checks the moves of a record that could be read, like FileHandler does.
+     * @param record The record.
+     * @return INVALID_MOVES or MISMATCHED_MOVES if the moves are invalid, VALID if not.
+     */
+    int checkMoves(const RecordView& record) {
+        int movesCount = MoveParser::parse(record.moves, nullptr);
+        if (MoveParser::parse(record.scramble, nullptr) == -1 || movesCount == -1) {
+            return FileHandler::INVALID_MOVES;
+        } else if (movesCount != record.totalMoves) {
+            return FileHandler::MISMATCHED_MOVES;
+        }
+
+        return FileHandler::VALID;
+    }
+}
+
+FileValidator::FileValidator(int numThreads, int chunkSize) {
+    this->numThreads = max(numThreads, 1);
+    this->chunkSize = max(chunkSize, 1);
+    errorLine = 0;
+    errorInJournal = false;
+    records = 0;
+}
+
+int FileValidator::validate(const string& fileName) {
+    this->fileName = fileName;
+    errorLine = 0;
+    errorInJournal = false;
+    records = 0;
+
+    // Records of the journal replace those of the file with the same name, so those are only counted once.
+    map<string, long long, less<>> journal = FileHandler::indexJournal(fileName);
+    bool foundData = false;
+    int status;
+
+    // A binary store has no lines, and its records are checked when they are read.
+    if (BinaryStore::checkFormat(fileName)) {
+        BinaryStore store;
+        status = store.load(fileName) ? FileHandler::VALID : FileHandler::BAD_FORMAT;
+        records = store.getCount();
+        foundData = records > 0;
+
+        for (const auto& entry : journal) {
+            records -= store.find(entry.first) != -1;
+        }
+    } else {
+        status = validateLines(fileName, journal, foundData);
+    }
+
+    if (status == FileHandler::VALID) {
+        status = validateJournal(fileName, foundData);
+        errorInJournal = status != FileHandler::VALID;
+    }
+
+    if (status != FileHandler::VALID) {
+        records = 0;
+        return status;
+    }
+
+    records += journal.size();
+    return foundData ? FileHandler::VALID : FileHandler::NO_DATA;
+}
+
+int FileValidator::validateJournal(const string& fileName, bool& foundData) {
+    RecordReader reader(fileName + FileHandler::JOURNAL_SUFFIX);
+    RecordView record;
+
+    // A journal line without a newline was cut off while being appended, so it was never saved.
+    while (reader.isOpen() && reader.next(record) && record.terminated) {
+        if (!foundData && record.checkBlank()) {
+            continue;
+        }
+
+        foundData = true;
+        int status = record.valid ? checkMoves(record) : FileHandler::BAD_FORMAT;
+        if (status != FileHandler::VALID) {
+            errorLine = record.lineNumber;
+            return status;
+        }
+    }
+
+    return FileHandler::VALID;
+}
+
+int FileValidator::validateLines(const string& fileName, const map<string, long long, less<>>& journal, bool& foundData) {
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd == -1) { return FileHandler::CANT_OPEN; }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return FileHandler::CANT_OPEN;
+    } else if (info.st_size == 0) {
+        close(fd);
+        return FileHandler::VALID;
+    }
+
+    size_t size = info.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) { return FileHandler::CANT_OPEN; }
+
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    const char* data = (const char*) mapping;
+
+    // Every chunk but the last ends just after a newline, so no line is split between chunks.
+    vector<pair<size_t, size_t>> chunks;
+    for (size_t start = 0; start < size;) {
+        size_t end = min(start + chunkSize, size);
+        const char* newline = (const char*) memchr(data + end - 1, '\n', size - end + 1);
+        end = (newline != nullptr) ? newline - data + 1 : size;
+
+        chunks.push_back({ start, end });
+        start = end;
+    }
+
+    vector<ChunkResult> results(chunks.size());
+    runTasks(numThreads, chunks.size(), [&](int chunk) {
+        validateChunk(string_view(data + chunks[chunk].first, chunks[chunk].second - chunks[chunk].first), chunk, results[chunk]);
+    });
+
+    // The line numbers of each chunk start after the lines of the chunks before it.
+    vector<long long> firstLines(chunks.size(), 0);
+    for (int i = 1; i < chunks.size(); i++) {
+        firstLines[i] = firstLines[i - 1] + results[i - 1].lines;
+    }
+
+    // Find the first invalid line, where blank lines are invalid once a record has been read, like in FileHandler.
+    int status = FileHandler::VALID;
+
+    for (int i = 0; i < chunks.size() && errorLine == 0; i++) {
+        const ChunkResult& result = results[i];
+
+        if (foundData && result.firstBlank != 0) {
+            errorLine = firstLines[i] + result.firstBlank;
+            status = FileHandler::BAD_FORMAT;
+        } else if (result.errorLine != 0) {
+            errorLine = firstLines[i] + result.errorLine;
+            status = result.errorStatus;
+        }
+
+        foundData = foundData || result.firstData != 0;
+    }
+
+    // A duplicate name is found before the moves of its line are checked, so it wins a tie.
+    vector<long long> duplicates(NUM_BUCKETS, 0);
+    runTasks(numThreads, NUM_BUCKETS, [&](int bucket) {
+        duplicates[bucket] = findDuplicate(results, firstLines, bucket);
+    });
+
+    for (long long line : duplicates) {
+        if (line != 0 && (errorLine == 0 || line <= errorLine)) {
+            errorLine = line;
+            status = FileHandler::DUPLICATE_NAMES;
+        }
+    }
+
+    if (status == FileHandler::VALID) {
+        for (const ChunkResult& result : results) {
+            records += result.records;
+
+            // The names view the mapping, so they are compared with the journal before it is unmapped.
+            for (int bucket = 0; bucket < NUM_BUCKETS && !journal.empty(); bucket++) {
+                for (const NameEntry& entry : result.buckets[bucket]) {
+                    records -= journal.count(entry.name);
+                }
+            }
+        }
+    }
+
+    munmap(mapping, size);
+    return status;
+}
+
+void FileValidator::validateChunk(string_view data, int chunk, ChunkResult& result) const {
+    result = { 0, 0, 0, 0, 0, FileHandler::VALID, vector<vector<NameEntry>>(NUM_BUCKETS) };
+    hash<string_view> hasher;
+    RecordView record;
+    size_t pos = 0;
+
+    while (pos < data.size()) {
+        size_t newline = data.find('\n', pos);
+        size_t end = (newline != string_view::npos) ? newline : data.size();
+        string_view line = data.substr(pos, end - pos);
+        pos = end + 1;
+        result.lines++;
+
+        // Lines after an error are only counted, since the first error of the chunk is the only one reported.
+        if (result.errorLine != 0) {
+            continue;
+        }
+
+        RecordReader::parse(line, record);
+        bool blank = record.checkBlank();
+        int status = FileHandler::VALID;
+
+        if (blank) {
+            result.firstBlank = (result.firstBlank == 0) ? result.lines : result.firstBlank;
+            status = (result.firstData != 0) ? FileHandler::BAD_FORMAT : FileHandler::VALID;
+        } else if (!record.valid) {
+            status = FileHandler::BAD_FORMAT;
+        } else {
+            result.buckets[hasher(record.name) % NUM_BUCKETS].push_back({ record.name, chunk, result.lines });
+
+            status = checkMoves(record);
+        }
+
+        if (!blank) {
+            result.firstData = (result.firstData == 0) ? result.lines : result.firstData;
+            result.records += (status == FileHandler::VALID);
+        }
+
+        if (status != FileHandler::VALID) {
+            result.errorLine = result.lines;
+            result.errorStatus = status;
+        }
+    }
+}
+
+long long FileValidator::findDuplicate(const vector<ChunkResult>& results, const vector<long long>& firstLines, int bucket) const {
+    vector<pair<string_view, long long>> names;
+
+    for (const ChunkResult& result : results) {
+        for (const NameEntry& entry : result.buckets[bucket]) {
+            names.push_back({ entry.name, firstLines[entry.chunk] + entry.line });
+        }
+    }
+
+    // After sorting, every later use of a name directly follows an earlier one.
+    sort(names.begin(), names.end());
+    long long res = 0;
+
+    for (size_t i = 1; i < names.size(); i++) {
+        if (names[i].first == names[i - 1].first && (res == 0 || names[i].second < res)) {
+            res = names[i].second;
+        }
+    }
+
+    return res;
+}
+
+long long FileValidator::getErrorLine() const { return errorLine; }
+
+string FileValidator::getErrorFile() const { return errorInJournal ? fileName + FileHandler::JOURNAL_SUFFIX : fileName; }
+
+long long FileValidator::getRecords() const { return records; }
+
+int FileValidator::getThreads() const { return numThreads; }
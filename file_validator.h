@@ -0,0 +1,125 @@
+#ifndef FILE_VALIDATOR_H
+#define FILE_VALIDATOR_H
+
+#include "file_handler.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+using namespace std;
+
+/**
+ * Validates a file of saved cubes like FileHandler does, using a pool of threads, without storing its records.
+ * The file is mapped into memory and split into chunks that end at newlines. Each thread checks the records of a chunk
+ * and sorts their names into buckets by hash, and then each thread looks for duplicates in a bucket.
+ * The journal of saves that were not compacted yet is then read line by line with the same rules as FileHandler, so the first
+ * error of the file or its journal is the one FileHandler would find loading them.
+ */
+class FileValidator {
+public:
+    static const int CHUNK_SIZE = 1 << 22; // The number of bytes of each chunk, which are extended to the next newline
+    static const int NUM_BUCKETS = 256;    // The number of groups of names checked for duplicates
+
+    /**
+     * Constructor for FileValidator.
+     * @param numThreads The number of threads that validate, at least 1.
+     * @param chunkSize The number of bytes of each chunk.
+     */
+    FileValidator(int numThreads, int chunkSize = CHUNK_SIZE);
+
+    /**
+     * Validates every record of a file, which may also be a BinaryStore, and then of its journal.
+     * @param fileName The name of the file.
+     * @return A value of FileHandler::VALID_STATUS, which is NO_DATA if both only hold whitespace.
+     */
+    int validate(const string& fileName);
+
+    /**
+     * Gets the line of the first error found by the last validation.
+     * @return The line number starting from 1, or 0 if there was no error in a line.
+     */
+    long long getErrorLine() const;
+
+    /**
+     * Gets the name of the file that contains the first error found by the last validation.
+     * @return The name of the file or of its journal.
+     */
+    string getErrorFile() const;
+
+    /**
+     * Gets the number of cubes in the file and journal of the last validation, if they were valid.
+     * @return The number of records, where a name saved to the journal counts once.
+     */
+    long long getRecords() const;
+
+    /**
+     * Gets the number of threads that validate.
+     * @return The number of threads.
+     */
+    int getThreads() const;
+private:
+    /**
+     * The name of a record and where it is.
+     */
+    struct NameEntry {
+        string_view name;
+        int chunk;
+        long long line;     // The line within the chunk, starting from 1
+    };
+
+    /**
+     * What a thread found in a chunk, with line numbers that start from 1 at the start of the chunk.
+     */
+    struct ChunkResult {
+        long long lines;
+        long long records;
+        long long firstData;    // The first line that is not blank, 0 if there is none
+        long long firstBlank;   // The first blank line, which is an error if a record comes before it
+        long long errorLine;    // The first invalid line after the first record of the chunk, 0 if there is none
+        int errorStatus;
+        vector<vector<NameEntry>> buckets;
+    };
+
+    /**
+     * Validates the lines of a file in chunks.
+     * @param fileName The name of the file.
+     * @param journal The index of the journal, whose names replace records of the file that are no longer counted.
+     * @param foundData Whether or not a record has been found, which will be updated.
+     * @return A value of FileHandler::VALID_STATUS.
+     */
+    int validateLines(const string& fileName, const map<string, long long, less<>>& journal, bool& foundData);
+
+    /**
+     * Validates the lines of a journal one at a time, where names may repeat and a cut off last line is ignored.
+     * @param fileName The name of the file whose journal is validated.
+     * @param foundData Whether or not a record has been found, which will be updated.
+     * @return A value of FileHandler::VALID_STATUS.
+     */
+    int validateJournal(const string& fileName, bool& foundData);
+
+    /**
+     * Checks the records of a chunk.
+     * @param data The bytes of the chunk.
+     * @param chunk The index of the chunk.
+     * @param result What was found, which will be updated.
+     */
+    void validateChunk(string_view data, int chunk, ChunkResult& result) const;
+
+    /**
+     * Finds the first line whose name was used by an earlier line, among the names of a bucket.
+     * @param results The results of every chunk.
+     * @param firstLines The line number before the first line of each chunk.
+     * @param bucket The index of the bucket.
+     * @return The line number, 0 if there are no duplicates.
+     */
+    long long findDuplicate(const vector<ChunkResult>& results, const vector<long long>& firstLines, int bucket) const;
+
+    int numThreads;
+    size_t chunkSize;
+    string fileName;
+    long long errorLine;
+    bool errorInJournal;
+    long long records;
+};
+
+#endif
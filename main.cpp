@@ -1,11 +1,29 @@
 #include "assistant.h"
+#include "two_phase_solver.h"
+#include "optimal_solver.h"
+#include "pattern_database.h"
 #include "cube.h"
 #include "file_handler.h"
+#include "batch_solver.h"
+#include "scrambler.h"
+#include "scramble_writer.h"
+#include "record_reader.h"
+#include "file_validator.h"
+#include "cube_batch.h"
+#include "compiled_sequence.h"
+#include "move_parser.h"
 #include "assistant_tests.h"
 #include "cube_tests.h"
+#include "cubie_cube_tests.h"
 #include "file_handler_tests.h"
+#include "two_phase_solver_tests.h"
+#include "optimal_solver_tests.h"
+#include "batch_solver_tests.h"
+#include "scrambler_tests.h"
 #include <iostream>
 #include <string>
+#include <vector>
+#include <map>
 #include <cstdlib>
 #include <ctime>
 #include <cctype>
@@ -13,6 +31,9 @@
 #include <sstream>
 #include <limits>
 #include <cstring>
+#include <thread>
+#include <random>
+#include <cstdint>
 using namespace std;
 
 void handleNewCube(Cube& cube, FileHandler& handler, bool randomized, bool& original, bool& usingCube);
@@ -21,6 +42,14 @@ void applyManualScramble(Cube& cube, string& scramble);
 void handleLoadCube(Cube& cube, FileHandler& handler, bool& original, bool& usingCube);
 void useCube(Cube& cube, FileHandler& handler, bool newCube);
 void saveCube(Cube& cube, FileHandler& handler, bool& successful);
+void applyQuickSolve(Cube& cube);
+void applyOptimalSolve(Cube& cube);
+int solveBatch(int argc, char* argv[]);
+int generateScrambles(int argc, char* argv[]);
+int convertStore(int argc, char* argv[]);
+int showStats(int argc, char* argv[]);
+int validateFile(int argc, char* argv[]);
+int evaluateSequence(int argc, char* argv[]);
 
 char getCharacterInput();
 void switchMenu(bool& original, bool& updated);
@@ -36,6 +65,18 @@ int main(int argc, char* argv[]) {
         char assistantStr[] = "assistant";
         char cubeStr[] = "cube";
         char fileHandlerStr[] = "file_handler";
+        char cubieCubeStr[] = "cubie_cube";
+        char twoPhaseSolverStr[] = "two_phase_solver";
+        char optimalSolverStr[] = "optimal_solver";
+        char batchSolverStr[] = "batch_solver";
+        char scramblerStr[] = "scrambler";
+        char generateDatabaseStr[] = "generate-pdb";
+        char solveBatchStr[] = "solve-batch";
+        char generateScramblesStr[] = "generate-scrambles";
+        char convertStr[] = "convert";
+        char statsStr[] = "stats";
+        char validateStr[] = "validate";
+        char evaluateStr[] = "evaluate";
 
         if (strcmp(arg, assistantStr) == 0) {
             cout << "\nTesting the Assistant...\n";
@@ -45,15 +86,71 @@ int main(int argc, char* argv[]) {
             cout << "\nTesting the Cube...\n";
             CubeTests test;
             return test.runTests();
+        } else if (strcmp(arg, cubieCubeStr) == 0) {
+            cout << "\nTesting the Cubie Cube...\n";
+            CubieCubeTests test;
+            return test.runTests();
         } else if (strcmp(arg, fileHandlerStr) == 0) {
             cout << "\nTesting the File Handler...\n";
             FileHandlerTests test;
             return test.runTests();
+        } else if (strcmp(arg, twoPhaseSolverStr) == 0) {
+            cout << "\nTesting the Two-Phase Solver...\n";
+            TwoPhaseSolverTests test;
+            return test.runTests();
+        } else if (strcmp(arg, optimalSolverStr) == 0) {
+            cout << "\nTesting the Optimal Solver...\n";
+            OptimalSolverTests test;
+            return test.runTests();
+        } else if (strcmp(arg, batchSolverStr) == 0) {
+            cout << "\nTesting the Batch Solver...\n";
+            BatchSolverTests test;
+            return test.runTests();
+        } else if (strcmp(arg, scramblerStr) == 0) {
+            cout << "\nTesting the Scrambler...\n";
+            ScramblerTests test;
+            return test.runTests();
+        } else if (strcmp(arg, solveBatchStr) == 0) {
+            return solveBatch(argc, argv);
+        } else if (strcmp(arg, generateScramblesStr) == 0) {
+            return generateScrambles(argc, argv);
+        } else if (strcmp(arg, convertStr) == 0) {
+            return convertStore(argc, argv);
+        } else if (strcmp(arg, statsStr) == 0) {
+            return showStats(argc, argv);
+        } else if (strcmp(arg, validateStr) == 0) {
+            return validateFile(argc, argv);
+        } else if (strcmp(arg, evaluateStr) == 0) {
+            return evaluateSequence(argc, argv);
+        } else if (strcmp(arg, generateDatabaseStr) == 0) {
+            string fileName = (argc > 2) ? argv[2] : PatternDatabase::DEFAULT_FILE_NAME;
+            cout << "\nGenerating the pattern database in \"" << fileName << "\"...\n";
+
+            if (!PatternDatabase::generate(fileName)) {
+                cout << "The file could not be written.\n";
+                return 1;
+            }
+
+            cout << "Done.\n";
+            return 0;
         } else {
             cout << "\nInvalid argument. The valid arguments are:\n";
-            cout << "\t   assistant - Test the Assistant class\n";
-            cout << "\t        cube - Test the Cube class\n";
-            cout << "\tfile_handler - Test the File Handler class\n";
+            cout << "\t       assistant - Test the Assistant class\n";
+            cout << "\t            cube - Test the Cube class\n";
+            cout << "\t      cubie_cube - Test the CubieCube class\n";
+            cout << "\t    file_handler - Test the File Handler class\n";
+            cout << "\ttwo_phase_solver - Test the TwoPhaseSolver class\n";
+            cout << "\t  optimal_solver - Test the OptimalSolver and PatternDatabase classes\n";
+            cout << "\t    batch_solver - Test the BatchSolver class\n";
+            cout << "\t       scrambler - Test the Scrambler, RandomGenerator, and ScrambleWriter classes\n";
+            cout << "\nOther commands:\n";
+            cout << "\t    generate-pdb [file] - Generate the pattern database used by the optimal solver\n";
+            cout << "\t    solve-batch <file> [--threads N] [--output file] - Solve every cube of a file with the assistant\n";
+            cout << "\t    generate-scrambles <count> <file> [--seed S] [--threads N] - Write random-state scrambles to a file\n";
+            cout << "\t    convert <file> <output> [--binary] - Convert saved cubes between the CSV and binary formats\n";
+            cout << "\t    stats <file> - Count the cubes and moves of a CSV file of any size\n";
+            cout << "\t    validate <file> [--threads N] - Check a file of saved cubes, one chunk per thread\n";
+            cout << "\t    evaluate <file> <moves> - Count the cubes of a CSV file that a sequence of moves solves\n";
             return 1;
         }
     }
@@ -77,7 +174,6 @@ int main(int argc, char* argv[]) {
     bool createdNewCube = false;
     char userInput;
 
-    srand(time(0));
     
     while (true) {
         // Lets the user interact with the options on the title screen.
@@ -206,51 +302,17 @@ void handleNewCube(Cube& cube, FileHandler& handler, bool randomized, bool& orig
 }
 
 /**
- * Randomly scrambles a given Cube.
+ * Scrambles a given Cube to a uniformly random state.
  * @param cube The cube to scramble.
  * @param scramble The scramble sequence to update.
  */
 void applyRandomScramble(Cube& cube, string& scramble) {
-    const int MAX_MOVES = 75000;
-    const int DEFAULT_MOVES = 25;
-    string validTurns = "ULFRBD";
-    string validModifiers = " '2";
-
-    // Prompt user moves.
-    int numMoves;
-    cout << "\nPlease enter the number of scrambling moves (max " << MAX_MOVES << "): ";
-    cin >> numMoves;
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-
-    // If invalid input, use default moves.
-    if (cin.fail() || numMoves < 0 || numMoves > MAX_MOVES) {
-        cin.clear();
-        numMoves = DEFAULT_MOVES;
-        cout << "\nCannot process that request, scrambling with " << numMoves << " moves instead.\n";
-    }
-
-    // Apply random moves.
-    int count = 0;
-    while (count < numMoves) {
-        // Disable double turn modifier at a count of one less to ensure the exact number of moves.
-        if (count == numMoves - 1) {
-            validModifiers = " \'";
-        }
-
-        int validTurnsIdx = rand() % validTurns.length();
-        int validModifiersIdx = rand() % validModifiers.length();
-
-        string add = string(1, validTurns[validTurnsIdx]) + string(1, validModifiers[validModifiersIdx]);
-        cube.doMoves(add, false);
-        scramble += add;
+    static Scrambler scrambler(((uint64_t) random_device()() << 32) ^ time(0));
 
-        // Increment counter.
-        if (validModifiersIdx == 2) {
-            count += 2;
-        } else {
-            count++;
-        }
-    }
+    cout << "\nGenerating a random state...\n";
+    scramble = scrambler.createScramble();
+    cube.doMoves(scramble, false);
+    cout << "Scramble: " << scramble << endl;
 }
 
 /**
@@ -384,7 +446,20 @@ void useCube(Cube& cube, FileHandler& handler, bool newCube) {
             cout << cube.undo();
             invalidInput = false;
         } else if (userInput == SOLVE_COMMAND) {
-            assistant.solve();
+            cout << "\n\t(A) Step through the assistant\n"
+                 << "\t(T) Apply a short solution from the two-phase solver\n"
+                 << "\t(O) Apply a shortest solution from the optimal solver (may take a long time)\n"
+                 << "How would you like to solve the cube? ";
+            char userResponse = getCharacterInput();
+
+            if (userResponse == 'T') {
+                applyQuickSolve(cube);
+            } else if (userResponse == 'O') {
+                applyOptimalSolve(cube);
+            } else {
+                assistant.solve();
+            }
+
             recentlySaved = false;
             invalidInput = false;
         } else {
@@ -397,6 +472,365 @@ void useCube(Cube& cube, FileHandler& handler, bool newCube) {
     handler.reset();
 }
 
+/**
+ * Solves the Cube with the two-phase solver, displaying and applying the solution.
+ * @param cube The Cube to solve.
+ */
+void applyQuickSolve(Cube& cube) {
+    TwoPhaseSolver solver;
+    pair<bool, string> solution = solver.solve(cube.getCubieCube(), TwoPhaseSolver::DEFAULT_MAX_LENGTH);
+
+    if (!solution.first) {
+        cout << "\nA solution could not be found.\n";
+    } else if (solver.getLength() == 0) {
+        cout << "\nThe cube is already solved.\n";
+    } else {
+        cout << "\nSolution (" << solver.getLength() << " moves): " << solution.second << endl;
+        cube.doMoves(solution.second, true);
+    }
+}
+
+/**
+ * Solves the Cube with the optimal solver, displaying the solution and the size of the search.
+ * @param cube The Cube to solve.
+ */
+void applyOptimalSolve(Cube& cube) {
+    PatternDatabase database;
+
+    if (!database.load(PatternDatabase::DEFAULT_FILE_NAME)) {
+        cout << "\nThe pattern database \"" << PatternDatabase::DEFAULT_FILE_NAME << "\" could not be loaded. "
+             << "Run the program with \"generate-pdb\" to create it.\n";
+        return;
+    }
+
+    OptimalSolver solver(database);
+    pair<bool, string> solution = solver.solve(cube.getCubieCube(), OptimalSolver::GODS_NUMBER);
+
+    if (!solution.first) {
+        cout << "\nA solution could not be found.\n";
+    } else if (solver.getLength() == 0) {
+        cout << "\nThe cube is already solved.\n";
+    } else {
+        cout << "\nSolution (" << solver.getLength() << " moves): " << solution.second << endl;
+        cube.doMoves(solution.second, true);
+    }
+
+    cout << "Searched " << solver.getNodes() << " nodes in " << solver.getElapsed() << " seconds with "
+         << solver.getThreads() << " threads.\n";
+}
+
+/**
+ * Solves every cube of a file with the assistant's method and writes the solutions to another file.
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments: solve-batch <file> [--threads N] [--output file].
+ * @return 0 if the file was solved, 1 if it was not.
+ */
+int solveBatch(int argc, char* argv[]) {
+    string inputFile = "";
+    string outputFile = "solutions.csv";
+    int threads = thread::hardware_concurrency();
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (inputFile.empty()) {
+            inputFile = argv[i];
+        }
+    }
+
+    if (inputFile.empty()) {
+        cout << "\nUsage: solve-batch <file> [--threads N] [--output file]\n";
+        return 1;
+    }
+
+    BatchSolver solver(threads);
+    if (!solver.solveFile(inputFile, outputFile)) {
+        cout << "\nError: Could not open \"" << inputFile << "\" or \"" << outputFile << "\".\n";
+        return 1;
+    }
+
+    cout << "\nSolved " << solver.getSolved() << " cubes with " << solver.getThreads() << " threads into \""
+         << outputFile << "\" (" << solver.getFailed() << " invalid).\n";
+    return 0;
+}
+
+/**
+ * Writes random-state scrambles to a file in the saved cubes format.
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments: generate-scrambles <count> <file> [--seed S] [--threads N].
+ * @return 0 if the file was written, 1 if it was not.
+ */
+int generateScrambles(int argc, char* argv[]) {
+    vector<string> positional;
+    uint64_t seed = 1;
+    int threads = thread::hardware_concurrency();
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else {
+            positional.push_back(argv[i]);
+        }
+    }
+
+    long long count = positional.size() == 2 ? atoll(positional[0].c_str()) : 0;
+    if (count <= 0) {
+        cout << "\nUsage: generate-scrambles <count> <file> [--seed S] [--threads N]\n";
+        return 1;
+    }
+
+    ScrambleWriter writer(threads);
+    if (!writer.writeFile(positional[1], count, seed)) {
+        cout << "\nError: Could not write \"" << positional[1] << "\".\n";
+        return 1;
+    }
+
+    cout << "\nWrote " << count << " scrambles with seed " << seed << " and " << writer.getThreads() << " threads to \""
+         << positional[1] << "\".\n";
+    return 0;
+}
+
+/**
+ * Converts a file of saved cubes, in either format, to a CSV file or a binary store.
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments: convert <file> <output> [--binary].
+ * @return 0 if the file was converted, 1 if it was not.
+ */
+int convertStore(int argc, char* argv[]) {
+    vector<string> positional;
+    bool binary = false;
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--binary") == 0) {
+            binary = true;
+        } else {
+            positional.push_back(argv[i]);
+        }
+    }
+
+    if (positional.size() != 2) {
+        cout << "\nUsage: convert <file> <output> [--binary]\n";
+        return 1;
+    }
+
+    FileHandler handler(positional[0]);
+    int status = handler.loadFile();
+    if (status != FileHandler::VALID && status != FileHandler::NO_DATA) {
+        handler.displayError(status);
+        return 1;
+    }
+
+    if (!handler.convert(positional[1], binary)) {
+        cout << "\nError: Could not write \"" << positional[1] << "\".\n";
+        return 1;
+    }
+
+    cout << "\nConverted \"" << positional[0] << "\" to the " << (binary ? "binary" : "CSV") << " format in \""
+         << positional[1] << "\".\n";
+    return 0;
+}
+
+/**
+ * Displays the number of cubes and moves in a CSV file and its journal, reading one line at a time so that any size of file can be read.
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments: stats <file>.
+ * @return 0 if the file was read, 1 if it was not.
+ */
+int showStats(int argc, char* argv[]) {
+    if (argc != 3) {
+        cout << "\nUsage: stats <file>\n";
+        return 1;
+    }
+
+    RecordReader reader(argv[2]);
+    if (!reader.isOpen()) {
+        cout << "\nError: Could not open \"" << argv[2] << "\".\n";
+        return 1;
+    }
+
+    map<string, long long, less<>> journal = FileHandler::indexJournal(argv[2]);
+    RecordReader journalReader(string(argv[2]) + FileHandler::JOURNAL_SUFFIX);
+    RecordView record;
+    long long cubes = 0;
+    long long invalid = 0;
+    long long firstInvalid = 0;
+    bool invalidInJournal = false;
+    long long snapshots = 0;
+    long long totalMoves = 0;
+    int mostMoves = 0;
+
+    auto count = [&](bool inJournal) {
+        // Records are checked like a file that is loaded, except for duplicate names, which would need every name in memory.
+        int movesCount = record.valid ? MoveParser::parse(record.moves, nullptr) : -1;
+        if (movesCount == -1 || movesCount != record.totalMoves || MoveParser::parse(record.scramble, nullptr) == -1) {
+            if (invalid++ == 0) {
+                firstInvalid = record.lineNumber;
+                invalidInJournal = inJournal;
+            }
+
+            return;
+        }
+
+        cubes++;
+        snapshots += !record.snapshot.empty();
+        totalMoves += record.totalMoves;
+        mostMoves = max(mostMoves, record.totalMoves);
+    };
+
+    // The newest records of the journal replace those of the file with the same name.
+    while (reader.next(record)) {
+        if (!record.checkBlank() && journal.count(record.name) == 0) {
+            count(false);
+        }
+    }
+
+    while (!journal.empty() && journalReader.next(record)) {
+        if (FileHandler::checkNewest(journal, record)) {
+            count(true);
+        }
+    }
+
+    cout << "\nCubes: " << cubes << " (" << snapshots << " with snapshots)\n";
+    cout << "Total moves: " << totalMoves << " (average " << (cubes > 0 ? (double) totalMoves / cubes : 0)
+         << ", most " << mostMoves << ")\n";
+    cout << "Invalid lines: " << invalid;
+    if (invalid > 0) {
+        cout << " (first on line " << firstInvalid << (invalidInJournal ? " of the journal" : "") << ")";
+    }
+
+    cout << endl;
+    return 0;
+}
+
+/**
+ * Checks every record of a file of saved cubes on a pool of threads, displaying the first error.
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments: validate <file> [--threads N].
+ * @return 0 if the file is valid, 1 if it is not.
+ */
+int validateFile(int argc, char* argv[]) {
+    string fileName = "";
+    int threads = thread::hardware_concurrency();
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (fileName.empty()) {
+            fileName = argv[i];
+        }
+    }
+
+    if (fileName.empty()) {
+        cout << "\nUsage: validate <file> [--threads N]\n";
+        return 1;
+    }
+
+    FileValidator validator(threads);
+    int status = validator.validate(fileName);
+    if (status != FileHandler::VALID) {
+        FileHandler handler(fileName);
+        handler.displayError(status);
+
+        if (validator.getErrorLine() > 0) {
+            cout << "The first error is on line " << validator.getErrorLine() << " of \"" << validator.getErrorFile() << "\".\n";
+        }
+
+        return 1;
+    }
+
+    cout << "\n\"" << fileName << "\" is valid, with " << validator.getRecords() << " cubes (checked with "
+         << validator.getThreads() << " threads).\n";
+    return 0;
+}
+
+/**
+ * Applies a sequence of moves to every cube of a CSV file and its journal, a batch at a time, and displays how many of them it solves.
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments: evaluate <file> <moves>.
+ * @return 0 if the file was read, 1 if it was not.
+ */
+int evaluateSequence(int argc, char* argv[]) {
+    const int BATCH_SIZE = 4096; // The number of cubes that the moves are applied to at a time
+
+    if (argc != 4) {
+        cout << "\nUsage: evaluate <file> <moves>\n";
+        return 1;
+    }
+
+    CompiledSequence sequence(argv[3]);
+    if (!sequence.isValid()) {
+        cout << "\nError: \"" << argv[3] << "\" is not a valid sequence of moves.\n";
+        return 1;
+    }
+
+    RecordReader reader(argv[2]);
+    if (!reader.isOpen()) {
+        cout << "\nError: Could not open \"" << argv[2] << "\".\n";
+        return 1;
+    }
+
+    map<string, long long, less<>> journal = FileHandler::indexJournal(argv[2]);
+    RecordReader journalReader(string(argv[2]) + FileHandler::JOURNAL_SUFFIX);
+    CubeBatch batch(BATCH_SIZE);
+    RecordView record;
+    int batched = 0;
+    long long cubes = 0;
+    long long solved = 0;
+    long long invalid = 0;
+    bool reading = true;
+    bool inJournal = false;
+
+    while (reading) {
+        // The newest records of the journal are read after the file, and replace its records with the same name.
+        if (!inJournal) {
+            reading = reader.next(record);
+            inJournal = !reading && !journal.empty();
+        }
+
+        if (inJournal) {
+            reading = journalReader.next(record);
+        }
+
+        bool used = inJournal ? FileHandler::checkNewest(journal, record) : !record.checkBlank() && journal.count(record.name) == 0;
+        if (reading && used) {
+            // The stickers are restored like a loaded cube, from the snapshot if it is intact and from the moves if not.
+            CubeState state;
+            bool valid = record.valid;
+
+            if (valid && !state.setSnapshot(RecordReader::removeSpaces(record.snapshot))) {
+                valid = state.applyMoves(RecordReader::removeSpaces(record.scramble))
+                    && state.applyMoves(RecordReader::removeSpaces(record.moves));
+            }
+
+            if (valid) {
+                batch.setCube(batched++, state);
+            } else {
+                invalid++;
+            }
+        }
+
+        // Only the cubes set since the last batch are counted, since the rest of the batch is left over.
+        if (batched == BATCH_SIZE || (!reading && batched > 0)) {
+            batch.applySequence(sequence);
+            solved += batch.countSolved(batched);
+            cubes += batched;
+            batched = 0;
+        }
+    }
+
+    cout << "\nSolved: " << solved << " of " << cubes << " cubes";
+    if (invalid > 0) {
+        cout << " (" << invalid << " invalid lines were skipped)";
+    }
+
+    cout << endl;
+    return 0;
+}
+
 /**
  * Handles the saving of a cube, displaying the status of the save.
  * @param cube The cube to save.
@@ -485,8 +919,9 @@ void displayGuide() {
          << "aligning the yellow edges, (6) positioning the yellow corners, and (7) orienting the yellow corners.\n\n";
 
     cout << "To start interacting with your Rubik's cube, either create a new cube or load in a pre-existing one.\n"
-         << "New Cube: You can scramble the new cube randomly or manually. You must provide a unique name for the\n"
-         << "          cube to ensure that you can come back to it later. The provided file may be empty.\n\n"
+         << "New Cube: You can scramble the new cube randomly or manually. A random scramble reaches any state with\n"
+         << "          equal chance. You must provide a unique name for the cube to ensure that you can come back to it\n"
+         << "          later. The provided file may be empty.\n\n"
          << "Load Cube: Alternatively, you can use a cube that has already been set up. Simply provide the file\n"
          << "           name to be processed. The data within this file must have comma-separated values containing\n"
          << "           a unique name, correctly formatted original scramble, the moves applied, and the total moves.\n"
@@ -498,7 +933,9 @@ void displayGuide() {
          << "a set of valid commands, which include performing moves, undoing a move, saving your cube, and exiting.\n\n";
     
     cout << "One of the commands is called \"SOLVE\", which is point of access to the assistant. From there, you may\n"
-         << "step through the stages of solving the cube, skip each stage, or exit the assistant.\n\n";
+         << "step through the stages of solving the cube, skip each stage, or exit the assistant. Alternatively, you\n"
+         << "may have the two-phase solver apply a short solution (about 20 moves) all at once, or have the optimal\n"
+         << "solver apply a shortest solution, which requires running the program once with \"generate-pdb\".\n\n";
     
     cout << "Notes:\n"
          << " * As the assistant uses the beginner's method of solving, the last step (yellow corner orientation)\n"
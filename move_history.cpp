@@ -0,0 +1,59 @@
+#include "move_history.h"
+#include "move_parser.h"
+#include <string>
+#include <vector>
+using namespace std;
+
+MoveHistory::MoveHistory() {
+    count = 0;
+    rendered = "";
+    renderedMoves = 0;
+}
+
+void MoveHistory::push(Move move) {
+    moves.push_back(move);
+    count += move.getCount();
+}
+
+void MoveHistory::push(const vector<Move>& moves) {
+    for (Move move : moves) {
+        push(move);
+    }
+}
+
+Move MoveHistory::pop() {
+    Move move = moves.back();
+
+    // Only trim the notation if the removed move was already converted.
+    if (renderedMoves == moves.size()) {
+        rendered.resize(rendered.length() - move.getLength());
+        renderedMoves--;
+    }
+
+    moves.pop_back();
+    count -= move.getCount();
+    return move;
+}
+
+void MoveHistory::clear() {
+    moves.clear();
+    count = 0;
+    rendered.clear();
+    renderedMoves = 0;
+}
+
+int MoveHistory::size() const { return moves.size(); }
+
+int MoveHistory::getCount() const { return count; }
+
+const string& MoveHistory::toString() const {
+    for (; renderedMoves < moves.size(); renderedMoves++) {
+        moves[renderedMoves].appendTo(rendered);
+    }
+
+    return rendered;
+}
+
+bool MoveHistory::operator==(const MoveHistory& rhs) const {
+    return moves == rhs.moves;
+}
@@ -0,0 +1,75 @@
+#ifndef MOVE_HISTORY_H
+#define MOVE_HISTORY_H
+
+#include "move_parser.h"
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * A contiguous history of moves stored as one byte per move, with a cached count and notation.
+ */
+class MoveHistory {
+public:
+    /**
+     * Constructor for an empty MoveHistory.
+     */
+    MoveHistory();
+
+    /**
+     * Adds a move to the end of the history.
+     * @param move The move to add.
+     */
+    void push(Move move);
+
+    /**
+     * Adds a list of moves to the end of the history.
+     * @param moves The moves to add.
+     */
+    void push(const vector<Move>& moves);
+
+    /**
+     * Removes the last move of the history. The history must not be empty.
+     * @return The removed move.
+     */
+    Move pop();
+
+    /**
+     * Removes every move from the history.
+     */
+    void clear();
+
+    /**
+     * Gets the number of entries in the history.
+     * @return The number of entries.
+     */
+    int size() const;
+
+    /**
+     * Gets the number of moves in the history (double moves count twice).
+     * @return The number of moves.
+     */
+    int getCount() const;
+
+    /**
+     * Gets the moves in order without spaces. Only moves added since the last call are converted.
+     * @return The notation of the history.
+     */
+    const string& toString() const;
+
+    /**
+     * Checks if histories are equal.
+     * @param rhs The MoveHistory to check against.
+     * @return Whether the moves are equal or not.
+     */
+    bool operator==(const MoveHistory& rhs) const;
+private:
+    vector<Move> moves;
+    int count;
+
+    // The notation of the first renderedMoves moves, extended lazily when requested.
+    mutable string rendered;
+    mutable int renderedMoves;
+};
+
+#endif
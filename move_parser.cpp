@@ -0,0 +1,132 @@
+#include "move_parser.h"
+#include "facelet_moves.h"
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+namespace {
+    /**
+     * Gets the index of a move letter.
+     * @param ch The character to check.
+     * @return The index of the letter in FaceletMoves::MOVE_LETTERS, -1 if it is not a move.
+     */
+    int getLetterIndex(char ch) {
+        switch (ch) {
+            case 'U': return 0;
+            case 'L': return 1;
+            case 'F': return 2;
+            case 'R': return 3;
+            case 'B': return 4;
+            case 'D': return 5;
+            case 'x': return 6;
+            case 'y': return 7;
+            case 'z': return 8;
+            default: return -1;
+        }
+    }
+}
+
+Move Move::create(int letter, int modifier) {
+    Move res = { (unsigned char) (letter * 4 + modifier) };
+    return res;
+}
+
+Move Move::fromIndex(int index) {
+    int turns = index % 3 + 1;
+    return create(index / 3, turns == 2 ? DOUBLE : (turns == 3 ? PRIME : NONE));
+}
+
+int Move::getLetterIndex() const { return code / 4; }
+
+char Move::getLetter() const { return FaceletMoves::MOVE_LETTERS[code / 4]; }
+
+int Move::getModifier() const { return code % 4; }
+
+int Move::getIndex() const {
+    int modifier = getModifier();
+    int turns = (modifier >= DOUBLE) ? 2 : (modifier == PRIME ? 3 : 1); // Double moves end up the same in either direction
+    return (code / 4) * 3 + turns - 1;
+}
+
+int Move::getCount() const { return getModifier() >= DOUBLE ? 2 : 1; }
+
+void Move::appendTo(string& str) const {
+    int modifier = getModifier();
+    str += getLetter();
+
+    if (modifier == PRIME || modifier == PRIME_DOUBLE) {
+        str += '\'';
+    }
+
+    if (modifier >= DOUBLE) {
+        str += '2';
+    }
+}
+
+int Move::getLength() const {
+    int modifier = getModifier();
+    return 1 + (modifier == PRIME || modifier == PRIME_DOUBLE ? 1 : 0) + (modifier >= DOUBLE ? 1 : 0);
+}
+
+bool Move::operator==(const Move& rhs) const { return code == rhs.code; }
+
+int MoveParser::parse(string_view moves, vector<Move>* res) {
+    int count = 0;
+    int letter = -1;       // The letter of the move being read
+    int modifier = Move::NONE;
+    bool canPrime = false; // Apostrophes must directly follow a letter
+    bool canDouble = false;
+
+    for (char ch : moves) {
+        if (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v' || ch == '\f') {
+            continue;
+        }
+
+        int next = getLetterIndex(ch);
+
+        if (next != -1) {
+            // Finish the previous move before starting a new one.
+            if (letter != -1 && res != nullptr) {
+                res->push_back(Move::create(letter, modifier));
+            }
+
+            letter = next;
+            modifier = Move::NONE;
+            canPrime = true;
+            canDouble = true;
+            count++;
+        } else if (ch == '\'' && canPrime) {
+            modifier = Move::PRIME;
+            canPrime = false;
+        } else if (ch == '2' && canDouble) {
+            modifier = (modifier == Move::PRIME) ? Move::PRIME_DOUBLE : Move::DOUBLE;
+            canPrime = false;
+            canDouble = false;
+            count++;
+        } else {
+            return -1;
+        }
+    }
+
+    if (letter != -1 && res != nullptr) {
+        res->push_back(Move::create(letter, modifier));
+    }
+
+    return count;
+}
+
+string MoveParser::toString(const vector<Move>& moves, bool spaced) {
+    string res;
+    res.reserve(moves.size() * (spaced ? 4 : 3));
+
+    for (int i = 0; i < moves.size(); i++) {
+        if (spaced && i > 0) {
+            res += ' ';
+        }
+
+        moves[i].appendTo(res);
+    }
+
+    return res;
+}
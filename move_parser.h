@@ -0,0 +1,102 @@
+#ifndef MOVE_PARSER_H
+#define MOVE_PARSER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+/**
+ * A single move packed into one byte: the index of its letter in FaceletMoves::MOVE_LETTERS and its modifier.
+ */
+struct Move {
+    enum Modifiers { NONE, PRIME, DOUBLE, PRIME_DOUBLE };
+
+    unsigned char code;
+
+    /**
+     * Creates a move from a letter index and modifier.
+     * @param letter The index of the letter in FaceletMoves::MOVE_LETTERS.
+     * @param modifier The modifier of the move.
+     * @return The packed move.
+     */
+    static Move create(int letter, int modifier);
+
+    /**
+     * Creates a move from its index in the permutation tables (see FaceletMoves).
+     * @param index The index of the move.
+     * @return The packed move, using a prime for counterclockwise quarter turns.
+     */
+    static Move fromIndex(int index);
+
+    /**
+     * Gets the index of the move's letter.
+     * @return The index of the letter in FaceletMoves::MOVE_LETTERS.
+     */
+    int getLetterIndex() const;
+
+    /**
+     * Gets the letter of the move.
+     * @return The letter, such as 'U' or 'x'.
+     */
+    char getLetter() const;
+
+    /**
+     * Gets the modifier of the move.
+     * @return A value of Modifiers.
+     */
+    int getModifier() const;
+
+    /**
+     * Gets the index of the move in the permutation tables (see FaceletMoves).
+     * @return The index of the move.
+     */
+    int getIndex() const;
+
+    /**
+     * Gets the number of moves that this move counts as (double moves count twice).
+     * @return 1 or 2.
+     */
+    int getCount() const;
+
+    /**
+     * Appends the move's notation to a string (ex: "U", "U'", "U2", or "U'2").
+     * @param str The string to append to.
+     */
+    void appendTo(string& str) const;
+
+    /**
+     * Gets the length of the move's notation.
+     * @return The number of characters appended by appendTo.
+     */
+    int getLength() const;
+
+    /**
+     * Checks if moves are equal.
+     * @param rhs The move to check against.
+     * @return Whether the letters and modifiers are equal or not.
+     */
+    bool operator==(const Move& rhs) const;
+};
+
+class MoveParser {
+public:
+    /**
+     * Validates, counts, and converts a sequence of moves in a single pass without building intermediate strings.
+     * Letters may be followed by "'" and then "2", and spaces between moves and modifiers are ignored.
+     * @param moves The sequence to parse.
+     * @param res The vector to append the moves to, or nullptr if only validation and counting are needed.
+     * @return The number of moves (double moves count twice), -1 if the sequence is invalid.
+     */
+    static int parse(string_view moves, vector<Move>* res);
+
+    /**
+     * Creates the notation of a list of moves.
+     * @param moves The moves to convert.
+     * @param spaced Whether or not the moves should be separated by spaces.
+     * @return A string with the moves.
+     */
+    static string toString(const vector<Move>& moves, bool spaced);
+};
+
+#endif
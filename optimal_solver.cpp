@@ -0,0 +1,214 @@
+#include "optimal_solver.h"
+#include "pattern_database.h"
+#include "cubie_cube.h"
+#include "facelet_moves.h"
+#include "move_parser.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+using namespace std;
+
+namespace {
+    /**
+     * The first moves of a subtree and the locations of the pieces after them.
+     */
+    struct Subtree {
+        PieceLocations locations;
+        int path[OptimalSolver::SPLIT_DEPTH];
+    };
+
+    /**
+     * One queue of subtrees per thread. A thread takes from the front of its own queue and, once it is empty,
+     * steals from the back of the others, so that threads with cheap subtrees help those with expensive ones.
+     */
+    class WorkQueues {
+    public:
+        WorkQueues(int numQueues) : queues(numQueues), mutexes(numQueues) {}
+
+        void push(int queue, const Subtree& subtree) {
+            queues[queue].push_back(subtree);
+        }
+
+        bool take(int queue, Subtree& subtree) {
+            {
+                lock_guard<mutex> lock(mutexes[queue]);
+                if (!queues[queue].empty()) {
+                    subtree = queues[queue].front();
+                    queues[queue].pop_front();
+                    return true;
+                }
+            }
+
+            for (size_t i = 1; i < queues.size(); i++) {
+                int victim = (queue + i) % queues.size();
+                lock_guard<mutex> lock(mutexes[victim]);
+                if (!queues[victim].empty()) {
+                    subtree = queues[victim].back();
+                    queues[victim].pop_back();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    private:
+        vector<deque<Subtree>> queues;
+        vector<mutex> mutexes;
+    };
+
+    /**
+     * Lists the subtrees below every sequence of SPLIT_DEPTH moves that could begin a solution.
+     */
+    void collectSubtrees(const PieceLocations& locations, int* path, int depth, vector<Subtree>& subtrees) {
+        if (depth == OptimalSolver::SPLIT_DEPTH) {
+            Subtree subtree;
+            subtree.locations = locations;
+            copy(path, path + depth, subtree.path);
+            subtrees.push_back(subtree);
+            return;
+        }
+
+        for (int move = 0; move < FaceletMoves::NUM_FACE_MOVES; move++) {
+            if (!FaceletMoves::checkFollows(move, depth > 0 ? path[depth - 1] : -1)) { continue; }
+
+            PieceLocations next = locations;
+            next.applyMove(move);
+            path[depth] = move;
+            collectSubtrees(next, path, depth + 1, subtrees);
+        }
+    }
+}
+
+OptimalSolver::OptimalSolver(const PatternDatabase& database)
+    : OptimalSolver(database, thread::hardware_concurrency()) {}
+
+OptimalSolver::OptimalSolver(const PatternDatabase& database, int numThreads) : found(false) {
+    this->database = &database;
+    this->numThreads = max(numThreads, 1);
+    length = -1;
+    nodes = 0;
+    elapsed = 0;
+}
+
+pair<bool, string> OptimalSolver::solve(const CubieCube& cube, int maxLength) {
+    auto start = chrono::steady_clock::now();
+    PieceLocations locations = PieceLocations::create(cube);
+    maxLength = min(maxLength, (int) GODS_NUMBER);
+    length = -1;
+    nodes = 0;
+
+    if (cube.verify() && database->isLoaded()) {
+        // Each iteration searches every sequence up to the next length, so the first solution found is the shortest.
+        for (int bound = database->estimate(locations); bound <= maxLength; bound++) {
+            bool solved;
+
+            if (bound > SPLIT_DEPTH && numThreads > 1) {
+                solved = searchParallel(locations, bound);
+            } else {
+                found = false;
+                solved = search(locations, moves, 0, bound, nodes);
+            }
+
+            if (solved) {
+                length = bound;
+                break;
+            }
+        }
+    }
+
+    elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (length == -1) {
+        return { false, "" };
+    }
+
+    vector<Move> solution;
+    for (int i = 0; i < length; i++) {
+        solution.push_back(Move::fromIndex(moves[i]));
+    }
+
+    return { true, MoveParser::toString(solution, true) };
+}
+
+int OptimalSolver::getLength() const { return length; }
+
+long long OptimalSolver::getNodes() const { return nodes; }
+
+int OptimalSolver::getThreads() const { return numThreads; }
+
+double OptimalSolver::getElapsed() const { return elapsed; }
+
+bool OptimalSolver::searchParallel(const PieceLocations& locations, int bound) {
+    vector<Subtree> subtrees;
+    int path[GODS_NUMBER + 1];
+    collectSubtrees(locations, path, 0, subtrees);
+    nodes += subtrees.size();
+
+    // Consecutive subtrees share their first moves, so each thread starts with a contiguous block
+    WorkQueues queues(numThreads);
+    for (size_t i = 0; i < subtrees.size(); i++) {
+        queues.push(i * numThreads / subtrees.size(), subtrees[i]);
+    }
+
+    found = false;
+    mutex solutionMutex;
+    vector<thread> threads;
+
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back([&, t]() {
+            int threadPath[GODS_NUMBER + 1];
+            long long threadNodes = 0;
+            Subtree subtree;
+
+            while (!found.load(memory_order_relaxed) && queues.take(t, subtree)) {
+                copy(subtree.path, subtree.path + SPLIT_DEPTH, threadPath);
+
+                if (search(subtree.locations, threadPath, SPLIT_DEPTH, bound - SPLIT_DEPTH, threadNodes)) {
+                    lock_guard<mutex> lock(solutionMutex);
+                    if (!found) {
+                        copy(threadPath, threadPath + bound, moves);
+                        found = true;
+                    }
+                }
+            }
+
+            lock_guard<mutex> lock(solutionMutex);
+            nodes += threadNodes;
+        });
+    }
+
+    for (thread& t : threads) {
+        t.join();
+    }
+
+    return found;
+}
+
+bool OptimalSolver::search(const PieceLocations& locations, int* path, int depth, int togo, long long& visited) const {
+    visited++;
+
+    int distance = database->estimate(locations);
+    if (distance > togo) { return false; }
+    if (togo == 0) { return true; } // Only the solved cube has an estimate of 0
+
+    for (int move = 0; move < FaceletMoves::NUM_FACE_MOVES; move++) {
+        if (found.load(memory_order_relaxed)) { return false; } // Another thread already solved this iteration
+        if (!FaceletMoves::checkFollows(move, depth > 0 ? path[depth - 1] : -1)) { continue; }
+
+        PieceLocations next = locations;
+        next.applyMove(move);
+        path[depth] = move;
+
+        if (search(next, path, depth + 1, togo - 1, visited)) {
+            return true;
+        }
+    }
+
+    return false;
+}
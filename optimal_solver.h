@@ -0,0 +1,95 @@
+#ifndef OPTIMAL_SOLVER_H
+#define OPTIMAL_SOLVER_H
+
+#include "cubie_cube.h"
+#include "pattern_database.h"
+#include <string>
+#include <utility>
+#include <atomic>
+using namespace std;
+
+/**
+ * Finds the shortest solutions of a cube with iterative deepening A* (IDA*), guided by a PatternDatabase.
+ * Random cubes take many millions of nodes, while cubes that are close to solved finish almost instantly.
+ * Each iteration is split into subtrees below the first few moves, which a pool of threads share by work stealing.
+ */
+class OptimalSolver {
+public:
+    static const int GODS_NUMBER = 20; // Every cube can be solved in 20 face turns
+
+    static const int SPLIT_DEPTH = 3; // Iterations are split into the subtrees below this many moves
+
+    /**
+     * Constructor for an OptimalSolver that searches with one thread per core.
+     * @param database The loaded tables used to estimate distances, which must outlive the solver.
+     */
+    OptimalSolver(const PatternDatabase& database);
+
+    /**
+     * Constructor for OptimalSolver.
+     * @param database The loaded tables used to estimate distances, which must outlive the solver.
+     * @param numThreads The number of threads that search, at least 1.
+     */
+    OptimalSolver(const PatternDatabase& database, int numThreads);
+
+    /**
+     * Finds a shortest sequence of face turns that solves a cube in its current orientation.
+     * @param cube The pieces of the cube to solve.
+     * @param maxLength The maximum number of face turns (double turns count once) to search.
+     * @return Whether or not a solution was found, and the moves separated by spaces (empty if already solved).
+     */
+    pair<bool, string> solve(const CubieCube& cube, int maxLength);
+
+    /**
+     * Gets the number of face turns in the last solution.
+     * @return The length of the last solution, -1 if none was found.
+     */
+    int getLength() const;
+
+    /**
+     * Gets the number of nodes visited by the last solve.
+     * @return The number of nodes.
+     */
+    long long getNodes() const;
+
+    /**
+     * Gets the number of threads that search.
+     * @return The number of threads.
+     */
+    int getThreads() const;
+
+    /**
+     * Gets the time taken by the last solve.
+     * @return The elapsed time in seconds.
+     */
+    double getElapsed() const;
+private:
+    /**
+     * Searches every subtree of one iteration in parallel, stopping all threads once any of them finds a solution.
+     * @param locations The locations of the pieces to solve.
+     * @param bound The length of the solutions searched for.
+     * @return Whether or not a solution was found.
+     */
+    bool searchParallel(const PieceLocations& locations, int bound);
+
+    /**
+     * Searches for solutions with exactly the remaining number of moves.
+     * @param locations The locations of the pieces.
+     * @param path The moves made so far, which is extended by the search.
+     * @param depth The number of moves made so far.
+     * @param togo The number of moves left.
+     * @param visited The counter of the nodes visited by the calling thread.
+     * @return Whether or not a solution was found.
+     */
+    bool search(const PieceLocations& locations, int* path, int depth, int togo, long long& visited) const;
+
+    const PatternDatabase* database;
+    int numThreads;
+    atomic<bool> found;
+    int length;
+    long long nodes;
+    double elapsed;
+    int moves[GODS_NUMBER + 1];
+};
+
+#endif
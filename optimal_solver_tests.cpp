@@ -0,0 +1,106 @@
+#include "optimal_solver_tests.h"
+#include "tester.h"
+#include "optimal_solver.h"
+#include "pattern_database.h"
+#include "cubie_cube.h"
+#include "cube.h"
+#include <string>
+#include <utility>
+using namespace std;
+
+int OptimalSolverTests::runTests() const {
+    Tester tester;
+    const string FILE_NAME = "test_files/pattern_database.bin";
+    PatternDatabase database;
+
+    // Test loading a file that is not a pattern database
+    {
+        bool passed = !database.load("test_files/valid_csv.txt") && !database.load("test_files/missing.bin") && !database.isLoaded()
+            && database.estimate(PieceLocations::create(CubieCube())) == 0;
+        tester.test("Files that do not exist or have the wrong size are not loaded, and nothing is estimated", passed);
+    }
+
+    // Test that piece locations follow the moves of the pieces
+    {
+        Cube cube;
+        cube.doMoves("RUR'U'F2D'B", false);
+        PieceLocations locations = PieceLocations::create(CubieCube());
+        int moves[] = { 9, 0, 11, 2, 7, 17, 12 };
+
+        for (int move : moves) {
+            locations.applyMove(move);
+        }
+
+        PieceLocations expected = PieceLocations::create(cube.getCubieCube());
+        bool passed = PatternDatabase::getCornerIndex(locations) == PatternDatabase::getCornerIndex(expected)
+            && PatternDatabase::getEdgeIndex(locations, 0) == PatternDatabase::getEdgeIndex(expected, 0)
+            && PatternDatabase::getEdgeIndex(locations, 1) == PatternDatabase::getEdgeIndex(expected, 1);
+        tester.test("Moving piece locations results in the same indices as moving the pieces", passed);
+    }
+
+    // Test generating and loading the pattern database (generated once and reused by later runs)
+    {
+        bool passed = database.load(FILE_NAME) || (PatternDatabase::generate(FILE_NAME) && database.load(FILE_NAME));
+        tester.test("The generated pattern database can be mapped", passed && database.isLoaded());
+    }
+
+    // The remaining tests need the tables, and an unloaded database has no estimates to check.
+    if (!database.isLoaded()) {
+        return tester.finishTests();
+    }
+
+    // Test the estimates of the pattern database
+    {
+        Cube cube;
+        cube.doMoves("RUF", false);
+        int solved = database.estimate(PieceLocations::create(CubieCube()));
+        int scrambled = database.estimate(PieceLocations::create(cube.getCubieCube()));
+        tester.test("Estimates are 0 for a solved cube and never overestimate", solved == 0 && scrambled > 0 && scrambled <= 3);
+    }
+
+    // Test solving a short scramble optimally
+    {
+        Cube cube;
+        cube.doMoves("RUR'U'", false);
+        OptimalSolver solver(database);
+        pair<bool, string> res = solver.solve(cube.getCubieCube(), OptimalSolver::GODS_NUMBER);
+        cube.doMoves(res.second, false);
+        bool passed = res.first && solver.getLength() == 4 && cube.checkSolved() && solver.getNodes() > 0 && solver.getElapsed() >= 0;
+        tester.test("A short scramble is solved in the fewest moves, with the search reported", passed);
+    }
+
+    // Test solving a longer scramble optimally
+    {
+        Cube cube;
+        cube.doMoves("F2 D' B U2 L' R2 D F' U", false);
+        OptimalSolver solver(database);
+        pair<bool, string> res = solver.solve(cube.getCubieCube(), OptimalSolver::GODS_NUMBER);
+        cube.doMoves(res.second, false);
+        tester.test("A longer scramble is solved in at most as many moves", res.first && solver.getLength() <= 9 && cube.checkSolved());
+    }
+
+    // Test the maximum length
+    {
+        Cube cube;
+        cube.doMoves("F2 D' B U2 L'", false);
+        OptimalSolver solver(database);
+        pair<bool, string> res = solver.solve(cube.getCubieCube(), 3);
+        tester.test("No solution is found when the maximum length is too short", !res.first && solver.getLength() == -1);
+    }
+
+    // Test that splitting the search between threads finds solutions of the same length
+    {
+        Cube cube;
+        cube.doMoves("R2 U F' L D2 B' R U'", false);
+        OptimalSolver single(database, 1);
+        OptimalSolver parallel(database, 4);
+        pair<bool, string> res1 = single.solve(cube.getCubieCube(), OptimalSolver::GODS_NUMBER);
+        pair<bool, string> res2 = parallel.solve(cube.getCubieCube(), OptimalSolver::GODS_NUMBER);
+        cube.doMoves(res2.second, false);
+        bool passed = res1.first && res2.first && parallel.getThreads() == 4 && single.getLength() == parallel.getLength()
+            && cube.checkSolved();
+        tester.test("Searching with several threads finds a solution of the same length as one thread", passed);
+    }
+
+    return tester.finishTests();
+}
@@ -0,0 +1,13 @@
+#ifndef OPTIMAL_SOLVER_TESTS_H
+#define OPTIMAL_SOLVER_TESTS_H
+
+class OptimalSolverTests {
+public:
+    /**
+     * Runs OptimalSolver and PatternDatabase tests.
+     * @return 0 if they passed, 1 if they did not.
+     */
+    int runTests() const;
+};
+
+#endif
@@ -0,0 +1,380 @@
+#include "pattern_database.h"
+#include "cubie_cube.h"
+#include "coordinates.h"
+#include "facelet_moves.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+using namespace std;
+
+const string PatternDatabase::DEFAULT_FILE_NAME = "pattern_database.bin";
+
+namespace {
+    const char FILE_MAGIC[8] = { 'R', 'C', 'A', 'P', 'D', 'B', '0', '1' };
+    const int NUM_MOVES = FaceletMoves::NUM_FACE_MOVES;
+    const int NUM_TWIST = 2187;          // 3^7 corner orientations
+    const int NUM_CORNER_PERM = 40320;   // 8! corner permutations
+    const int NUM_EDGE_POSITIONS = 665280; // 12! / 6! slots of six edges
+    const int NUM_EDGE_FLIPS = 64;       // 2^6 orientations of six edges
+    const unsigned char UNKNOWN = 0xF;
+
+    struct FileHeader {
+        char magic[8];
+        unsigned int cornerStates;
+        unsigned int edgeStates;
+    };
+
+    struct SlotMoves {
+        // For each face turn, where the piece in each slot goes and how much it twists or flips.
+        unsigned char cornerDest[NUM_MOVES][CubieCube::NUM_CORNERS];
+        unsigned char cornerTwist[NUM_MOVES][CubieCube::NUM_CORNERS];
+        unsigned char edgeDest[NUM_MOVES][CubieCube::NUM_EDGES];
+        unsigned char edgeFlip[NUM_MOVES][CubieCube::NUM_EDGES];
+    };
+
+    SlotMoves buildSlotMoves() {
+        SlotMoves res;
+
+        for (int move = 0; move < NUM_MOVES; move++) {
+            CubieCube cube;
+            cube.applyMove(move);
+
+            // The piece that was in slot cp[i] ends up in slot i.
+            for (int i = 0; i < CubieCube::NUM_CORNERS; i++) {
+                res.cornerDest[move][cube.cp[i]] = i;
+                res.cornerTwist[move][cube.cp[i]] = cube.co[i];
+            }
+
+            for (int i = 0; i < CubieCube::NUM_EDGES; i++) {
+                res.edgeDest[move][cube.ep[i]] = i;
+                res.edgeFlip[move][cube.ep[i]] = cube.eo[i];
+            }
+        }
+
+        return res;
+    }
+
+    const SlotMoves& getSlotMoves() {
+        static const SlotMoves MOVES = buildSlotMoves();
+        return MOVES;
+    }
+
+    /**
+     * Gets the twist coordinate of the corner orientations, which are indexed by slot.
+     * @param twists The orientation of the corner in each slot.
+     * @return The twist coordinate.
+     */
+    int packTwist(const unsigned char* twists) {
+        int res = 0;
+        for (int i = 0; i < CubieCube::NUM_CORNERS - 1; i++) {
+            res = res * 3 + twists[i];
+        }
+
+        return res;
+    }
+
+    void unpackTwist(int twist, unsigned char* twists) {
+        int total = 0;
+        for (int i = CubieCube::NUM_CORNERS - 2; i >= 0; i--) {
+            twists[i] = twist % 3;
+            total += twists[i];
+            twist /= 3;
+        }
+
+        twists[CubieCube::NUM_CORNERS - 1] = (3 - total % 3) % 3;
+    }
+
+    unsigned char getEntry(const unsigned char* table, long long index) {
+        return (table[index / 2] >> ((index % 2) * 4)) & 0xF;
+    }
+
+    void setEntry(unsigned char* table, long long index, unsigned char value) {
+        unsigned char& byte = table[index / 2];
+        int shift = (index % 2) * 4;
+        byte = (byte & ~(0xF << shift)) | (value << shift);
+    }
+
+    /**
+     * Fills a table of 4-bit distances with a breadth-first search from the solved state.
+     * Once a layer is larger than the unvisited states, the unvisited states search for a neighbor in the layer instead.
+     * @param size The number of states.
+     * @param start The index of the solved state.
+     * @param next A function that gets the index reached by applying a face turn to an index.
+     * @return The table, two entries per byte.
+     */
+    template <typename Next>
+    vector<unsigned char> buildTable(long long size, int start, Next next) {
+        vector<unsigned char> table((size + 1) / 2, 0xFF);
+        setEntry(table.data(), start, 0);
+        long long visited = 1;
+        long long layer = 1;
+
+        for (int depth = 0; layer > 0 && depth + 1 < UNKNOWN; depth++) {
+            bool backward = layer > size - visited;
+            layer = 0;
+
+            for (long long i = 0; i < size; i++) {
+                unsigned char entry = getEntry(table.data(), i);
+
+                if (!backward && entry == depth) {
+                    for (int move = 0; move < NUM_MOVES; move++) {
+                        long long neighbor = next(i, move);
+
+                        if (getEntry(table.data(), neighbor) == UNKNOWN) {
+                            setEntry(table.data(), neighbor, depth + 1);
+                            layer++;
+                        }
+                    }
+                } else if (backward && entry == UNKNOWN) {
+                    for (int move = 0; move < NUM_MOVES; move++) {
+                        if (getEntry(table.data(), next(i, move)) == depth) {
+                            setEntry(table.data(), i, depth + 1);
+                            layer++;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            visited += layer;
+        }
+
+        return table;
+    }
+
+    vector<unsigned char> buildCornerTable() {
+        const SlotMoves& moves = getSlotMoves();
+        vector<unsigned short> permMoves(NUM_CORNER_PERM * NUM_MOVES);
+        vector<unsigned short> twistMoves(NUM_TWIST * NUM_MOVES);
+
+        for (int i = 0; i < NUM_CORNER_PERM; i++) {
+            unsigned char slots[CubieCube::NUM_CORNERS];
+            Coordinates::unrankPermutation(i, slots, CubieCube::NUM_CORNERS, 0);
+
+            for (int move = 0; move < NUM_MOVES; move++) {
+                unsigned char moved[CubieCube::NUM_CORNERS];
+                for (int piece = 0; piece < CubieCube::NUM_CORNERS; piece++) {
+                    moved[piece] = moves.cornerDest[move][slots[piece]];
+                }
+
+                permMoves[i * NUM_MOVES + move] = Coordinates::rankPermutation(moved, CubieCube::NUM_CORNERS);
+            }
+        }
+
+        for (int i = 0; i < NUM_TWIST; i++) {
+            unsigned char twists[CubieCube::NUM_CORNERS];
+            unpackTwist(i, twists);
+
+            for (int move = 0; move < NUM_MOVES; move++) {
+                unsigned char moved[CubieCube::NUM_CORNERS];
+                for (int slot = 0; slot < CubieCube::NUM_CORNERS; slot++) {
+                    moved[moves.cornerDest[move][slot]] = (twists[slot] + moves.cornerTwist[move][slot]) % 3;
+                }
+
+                twistMoves[i * NUM_MOVES + move] = packTwist(moved);
+            }
+        }
+
+        return buildTable(PatternDatabase::NUM_CORNER_STATES, PatternDatabase::getCornerIndex(PieceLocations::create(CubieCube())),
+            [&](long long index, int move) {
+                int perm = index / NUM_TWIST;
+                int twist = index % NUM_TWIST;
+                return (long long) permMoves[perm * NUM_MOVES + move] * NUM_TWIST + twistMoves[twist * NUM_MOVES + move];
+            });
+    }
+
+    vector<unsigned char> buildEdgeTable(int group) {
+        const SlotMoves& moves = getSlotMoves();
+        const int SIZE = PatternDatabase::EDGE_GROUP_SIZE;
+        vector<unsigned int> positionMoves((long long) NUM_EDGE_POSITIONS * NUM_MOVES);
+        vector<unsigned char> flipMasks((long long) NUM_EDGE_POSITIONS * NUM_MOVES);
+
+        // Flips depend on the slots of the edges, so each position stores the flips caused by each move.
+        for (int i = 0; i < NUM_EDGE_POSITIONS; i++) {
+            unsigned char slots[SIZE];
+            Coordinates::unrankSelection(i, slots, SIZE, CubieCube::NUM_EDGES);
+
+            for (int move = 0; move < NUM_MOVES; move++) {
+                unsigned char moved[SIZE];
+                unsigned char mask = 0;
+
+                for (int k = 0; k < SIZE; k++) {
+                    moved[k] = moves.edgeDest[move][slots[k]];
+                    mask |= moves.edgeFlip[move][slots[k]] << k;
+                }
+
+                positionMoves[(long long) i * NUM_MOVES + move] = Coordinates::rankSelection(moved, SIZE, CubieCube::NUM_EDGES);
+                flipMasks[(long long) i * NUM_MOVES + move] = mask;
+            }
+        }
+
+        return buildTable(PatternDatabase::NUM_EDGE_STATES, PatternDatabase::getEdgeIndex(PieceLocations::create(CubieCube()), group),
+            [&](long long index, int move) {
+                long long position = index / NUM_EDGE_FLIPS;
+                int flips = index % NUM_EDGE_FLIPS;
+                return (long long) positionMoves[position * NUM_MOVES + move] * NUM_EDGE_FLIPS + (flips ^ flipMasks[position * NUM_MOVES + move]);
+            });
+    }
+}
+
+PieceLocations PieceLocations::create(const CubieCube& cube) {
+    PieceLocations res;
+
+    for (int slot = 0; slot < CubieCube::NUM_CORNERS; slot++) {
+        res.cornerSlots[cube.cp[slot]] = slot;
+        res.cornerTwists[cube.cp[slot]] = cube.co[slot];
+    }
+
+    for (int slot = 0; slot < CubieCube::NUM_EDGES; slot++) {
+        res.edgeSlots[cube.ep[slot]] = slot;
+        res.edgeFlips[cube.ep[slot]] = cube.eo[slot];
+    }
+
+    return res;
+}
+
+void PieceLocations::applyMove(int move) {
+    const SlotMoves& moves = getSlotMoves();
+
+    for (int piece = 0; piece < CubieCube::NUM_CORNERS; piece++) {
+        int slot = cornerSlots[piece];
+        cornerSlots[piece] = moves.cornerDest[move][slot];
+        cornerTwists[piece] = (cornerTwists[piece] + moves.cornerTwist[move][slot]) % 3;
+    }
+
+    for (int piece = 0; piece < CubieCube::NUM_EDGES; piece++) {
+        int slot = edgeSlots[piece];
+        edgeSlots[piece] = moves.edgeDest[move][slot];
+        edgeFlips[piece] ^= moves.edgeFlip[move][slot];
+    }
+}
+
+bool PatternDatabase::generate(const string& fileName) {
+    ofstream ofs(fileName, ios::binary | ios::trunc);
+    if (!ofs) { return false; }
+
+    FileHeader header;
+    memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.cornerStates = NUM_CORNER_STATES;
+    header.edgeStates = NUM_EDGE_STATES;
+    ofs.write((const char*) &header, sizeof(header));
+
+    // Build one table at a time to limit the memory in use.
+    vector<unsigned char> table = buildCornerTable();
+    ofs.write((const char*) table.data(), table.size());
+
+    for (int group = 0; group < NUM_EDGE_GROUPS; group++) {
+        table = buildEdgeTable(group);
+        ofs.write((const char*) table.data(), table.size());
+    }
+
+    return (bool) ofs;
+}
+
+int PatternDatabase::getCornerIndex(const PieceLocations& locations) {
+    unsigned char twists[CubieCube::NUM_CORNERS];
+    for (int piece = 0; piece < CubieCube::NUM_CORNERS; piece++) {
+        twists[locations.cornerSlots[piece]] = locations.cornerTwists[piece];
+    }
+
+    return Coordinates::rankPermutation(locations.cornerSlots, CubieCube::NUM_CORNERS) * NUM_TWIST + packTwist(twists);
+}
+
+int PatternDatabase::getEdgeIndex(const PieceLocations& locations, int group) {
+    const unsigned char* slots = locations.edgeSlots + group * EDGE_GROUP_SIZE;
+    const unsigned char* flips = locations.edgeFlips + group * EDGE_GROUP_SIZE;
+    int mask = 0;
+
+    for (int k = 0; k < EDGE_GROUP_SIZE; k++) {
+        mask |= flips[k] << k;
+    }
+
+    return Coordinates::rankSelection(slots, EDGE_GROUP_SIZE, CubieCube::NUM_EDGES) * NUM_EDGE_FLIPS + mask;
+}
+
+PatternDatabase::PatternDatabase() {
+    mapping = nullptr;
+    mappingSize = 0;
+    cornerTable = nullptr;
+
+    for (int group = 0; group < NUM_EDGE_GROUPS; group++) {
+        edgeTables[group] = nullptr;
+    }
+}
+
+PatternDatabase::~PatternDatabase() {
+    unload();
+}
+
+bool PatternDatabase::load(const string& fileName) {
+    unload();
+
+    const size_t CORNER_BYTES = (NUM_CORNER_STATES + 1) / 2;
+    const size_t EDGE_BYTES = (NUM_EDGE_STATES + 1) / 2;
+    const size_t EXPECTED_SIZE = sizeof(FileHeader) + CORNER_BYTES + NUM_EDGE_GROUPS * EDGE_BYTES;
+
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd == -1) { return false; }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size != EXPECTED_SIZE) {
+        close(fd);
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor is closed, and its pages are shared with other processes.
+    void* data = mmap(nullptr, EXPECTED_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) { return false; }
+
+    const FileHeader* header = (const FileHeader*) data;
+    if (memcmp(header->magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0
+    || header->cornerStates != NUM_CORNER_STATES || header->edgeStates != NUM_EDGE_STATES) {
+        munmap(data, EXPECTED_SIZE);
+        return false;
+    }
+
+    mapping = data;
+    mappingSize = EXPECTED_SIZE;
+    cornerTable = (const unsigned char*) data + sizeof(FileHeader);
+
+    for (int group = 0; group < NUM_EDGE_GROUPS; group++) {
+        edgeTables[group] = cornerTable + CORNER_BYTES + group * EDGE_BYTES;
+    }
+
+    return true;
+}
+
+bool PatternDatabase::isLoaded() const { return mapping != nullptr; }
+
+int PatternDatabase::estimate(const PieceLocations& locations) const {
+    if (!isLoaded()) { return 0; }
+
+    int res = getEntry(cornerTable, getCornerIndex(locations));
+
+    for (int group = 0; group < NUM_EDGE_GROUPS; group++) {
+        res = max(res, (int) getEntry(edgeTables[group], getEdgeIndex(locations, group)));
+    }
+
+    return res;
+}
+
+void PatternDatabase::unload() {
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+    }
+
+    mapping = nullptr;
+    mappingSize = 0;
+    cornerTable = nullptr;
+
+    for (int group = 0; group < NUM_EDGE_GROUPS; group++) {
+        edgeTables[group] = nullptr;
+    }
+}
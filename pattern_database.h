@@ -0,0 +1,110 @@
+#ifndef PATTERN_DATABASE_H
+#define PATTERN_DATABASE_H
+
+#include "cubie_cube.h"
+#include <string>
+#include <cstddef>
+using namespace std;
+
+/**
+ * The slot and orientation of every piece, indexed by piece, which is how the pattern databases address a cube.
+ */
+struct PieceLocations {
+    unsigned char cornerSlots[CubieCube::NUM_CORNERS];
+    unsigned char cornerTwists[CubieCube::NUM_CORNERS];
+    unsigned char edgeSlots[CubieCube::NUM_EDGES];
+    unsigned char edgeFlips[CubieCube::NUM_EDGES];
+
+    /**
+     * Gets the locations of the pieces of a CubieCube.
+     * @param cube The pieces to locate.
+     * @return The locations of the pieces.
+     */
+    static PieceLocations create(const CubieCube& cube);
+
+    /**
+     * Moves every piece by a face turn.
+     * @param move The index of the face turn (see FaceletMoves).
+     */
+    void applyMove(int move);
+};
+
+/**
+ * Lower bounds on the number of face turns needed to solve the corners and two halves of the edges.
+ * The tables are generated once, written to a file, and mapped read-only into memory so that every process shares them.
+ */
+class PatternDatabase {
+public:
+    static const int NUM_CORNER_STATES = 88179840; // 8! * 3^7
+    static const int NUM_EDGE_STATES = 42577920;   // 12! / 6! * 2^6
+    static const int NUM_EDGE_GROUPS = 2;
+    static const int EDGE_GROUP_SIZE = 6;
+    static const string DEFAULT_FILE_NAME;
+
+    /**
+     * Generates every table with a breadth-first search and writes them to a file, which takes several seconds.
+     * @param fileName The name of the file to write.
+     * @return Whether or not the file was written.
+     */
+    static bool generate(const string& fileName);
+
+    /**
+     * Gets the index of the corners in the corner table.
+     * @param locations The locations of the pieces.
+     * @return The index of the corners.
+     */
+    static int getCornerIndex(const PieceLocations& locations);
+
+    /**
+     * Gets the index of a group of six edges in its edge table.
+     * @param locations The locations of the pieces.
+     * @param group The group of edges (0 for UR to DF, 1 for DL to BR).
+     * @return The index of the edges.
+     */
+    static int getEdgeIndex(const PieceLocations& locations, int group);
+
+    /**
+     * Constructor for an empty PatternDatabase.
+     */
+    PatternDatabase();
+
+    /**
+     * Unmaps the tables.
+     */
+    ~PatternDatabase();
+
+    PatternDatabase(const PatternDatabase&) = delete;
+    PatternDatabase& operator=(const PatternDatabase&) = delete;
+
+    /**
+     * Maps a file written by generate into memory, replacing any tables that were loaded before.
+     * @param fileName The name of the file to map.
+     * @return Whether or not the file exists and has the expected format.
+     */
+    bool load(const string& fileName);
+
+    /**
+     * Checks if tables have been loaded.
+     * @return Whether or not the tables are available.
+     */
+    bool isLoaded() const;
+
+    /**
+     * Gets the largest lower bound of the tables, which never overestimates the distance to the solved cube.
+     * @param locations The locations of the pieces.
+     * @return The minimum number of face turns needed to solve the cube, or 0 if no tables are loaded.
+     */
+    int estimate(const PieceLocations& locations) const;
+private:
+    /**
+     * Unmaps the tables if they are loaded.
+     */
+    void unload();
+
+    void* mapping;
+    size_t mappingSize;
+    const unsigned char* cornerTable;
+    const unsigned char* edgeTables[NUM_EDGE_GROUPS];
+};
+
+#endif
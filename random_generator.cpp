@@ -0,0 +1,71 @@
+#include "random_generator.h"
+#include <cstdint>
+using namespace std;
+
+namespace {
+    uint64_t rotateLeft(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+}
+
+RandomGenerator::RandomGenerator(uint64_t seed) {
+    // splitmix64 never produces an all-zero state, which xoshiro cannot leave.
+    for (int i = 0; i < 4; i++) {
+        seed += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        state[i] = z ^ (z >> 31);
+    }
+}
+
+uint64_t RandomGenerator::next() {
+    uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+    uint64_t t = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotateLeft(state[3], 45);
+
+    return result;
+}
+
+uint32_t RandomGenerator::nextBelow(uint32_t bound) {
+    // Lemire's method: scale 32 random bits by the bound and reject the few values that would be overrepresented.
+    uint64_t product = (next() >> 32) * bound;
+    uint32_t low = (uint32_t) product;
+
+    if (low < bound) {
+        uint32_t threshold = -bound % bound;
+        while (low < threshold) {
+            product = (next() >> 32) * bound;
+            low = (uint32_t) product;
+        }
+    }
+
+    return product >> 32;
+}
+
+void RandomGenerator::jump() {
+    const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+    uint64_t jumped[4] = { 0, 0, 0, 0 };
+
+    for (uint64_t mask : JUMP) {
+        for (int bit = 0; bit < 64; bit++) {
+            if (mask & (1ULL << bit)) {
+                for (int i = 0; i < 4; i++) {
+                    jumped[i] ^= state[i];
+                }
+            }
+
+            next();
+        }
+    }
+
+    for (int i = 0; i < 4; i++) {
+        state[i] = jumped[i];
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef RANDOM_GENERATOR_H
+#define RANDOM_GENERATOR_H
+
+#include <cstdint>
+using namespace std;
+
+/**
+ * A fast, seedable pseudorandom number generator (xoshiro256**).
+ * The same seed always produces the same sequence on every platform.
+ */
+class RandomGenerator {
+public:
+    /**
+     * Constructor for RandomGenerator.
+     * @param seed Any value; the state is expanded from it with splitmix64 so that similar seeds give unrelated sequences.
+     */
+    RandomGenerator(uint64_t seed);
+
+    /**
+     * Gets the next 64 random bits.
+     * @return A uniformly random integer.
+     */
+    uint64_t next();
+
+    /**
+     * Gets a random integer below a bound without modulo bias.
+     * @param bound The number of possible values, at least 1.
+     * @return A uniformly random integer from 0 to bound - 1.
+     */
+    uint32_t nextBelow(uint32_t bound);
+
+    /**
+     * Advances the generator by 2^128 numbers, which starts a stream that never overlaps the numbers before the jump.
+     */
+    void jump();
+private:
+    uint64_t state[4];
+};
+
+#endif
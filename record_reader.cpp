@@ -0,0 +1,140 @@
+#include "record_reader.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <cctype>
+#include <climits>
+using namespace std;
+
+namespace {
+    /**
+     * Gets the field that starts at a position, which ends before the next comma.
+     * @param line The line to read.
+     * @param pos The position of the field, which will be moved past its comma (or to the end of the line).
+     * @return The field without its comma.
+     */
+    string_view nextField(string_view line, size_t& pos) {
+        size_t start = min(pos, line.size());
+        size_t comma = line.find(',', start);
+
+        if (comma == string_view::npos) {
+            pos = line.size() + 1;
+            return line.substr(start);
+        }
+
+        pos = comma + 1;
+        return line.substr(start, comma - start);
+    }
+
+    /**
+     * Reads an integer the way an istream does, skipping leading whitespace and ignoring what follows its digits.
+     * @param field The field to read.
+     * @param value The integer, which will be updated.
+     * @return Whether or not the field starts with an integer that fits in an int.
+     */
+    bool readInteger(string_view field, int& value) {
+        size_t i = 0;
+        while (i < field.size() && isspace((unsigned char) field[i])) {
+            i++;
+        }
+
+        bool negative = i < field.size() && field[i] == '-';
+        if (i < field.size() && (field[i] == '-' || field[i] == '+')) {
+            i++;
+        }
+
+        long long res = 0;
+        size_t digits = i;
+        while (i < field.size() && isdigit((unsigned char) field[i])) {
+            res = res * 10 + (field[i] - '0');
+            if (res > (long long) INT_MAX + 1) { return false; }
+            i++;
+        }
+
+        res = negative ? -res : res;
+        if (i == digits || res > INT_MAX || res < INT_MIN) { return false; }
+
+        value = res;
+        return true;
+    }
+}
+
+bool RecordView::checkBlank() const {
+    for (char ch : line) {
+        if (!isspace((unsigned char) ch)) { return false; }
+    }
+
+    return true;
+}
+
+bool RecordReader::parse(string_view line, RecordView& record) {
+    size_t pos = 0;
+    record.line = line;
+    record.name = nextField(line, pos);
+    record.scramble = nextField(line, pos);
+    record.moves = nextField(line, pos);
+
+    // The number of total moves is the last required field, and older files have no snapshot after it.
+    bool hasNumber = pos <= line.size();
+    string_view number = nextField(line, pos);
+    record.snapshot = nextField(line, pos);
+    record.valid = hasNumber && readInteger(number, record.totalMoves);
+
+    return record.valid;
+}
+
+string RecordReader::removeSpaces(string_view field) {
+    string res;
+    res.reserve(field.size());
+
+    for (char ch : field) {
+        if (ch != ' ') {
+            res += ch;
+        }
+    }
+
+    return res;
+}
+
+RecordReader::RecordReader(const string& fileName, int bufferSize) : ifs(fileName, ios::binary), buffer(max(bufferSize, 1)) {
+    start = 0;
+    end = 0;
+    bufferOffset = 0;
+    lineNumber = 0;
+    finished = false;
+}
+
+bool RecordReader::isOpen() const { return ifs.is_open(); }
+
+bool RecordReader::next(RecordView& record) {
+    const char* newline;
+
+    // Refill the buffer until it holds a whole line, keeping the unread bytes at its front.
+    while ((newline = (const char*) memchr(buffer.data() + start, '\n', end - start)) == nullptr && !finished) {
+        memmove(buffer.data(), buffer.data() + start, end - start);
+        end -= start;
+        bufferOffset += start;
+        start = 0;
+
+        if (end == buffer.size()) { // The line is longer than the buffer
+            buffer.resize(buffer.size() * 2);
+        }
+
+        ifs.read(buffer.data() + end, buffer.size() - end);
+        end += ifs.gcount();
+        finished = ifs.gcount() == 0;
+    }
+
+    // A last line without a newline is still read, like getline would.
+    size_t lineEnd = (newline != nullptr) ? newline - buffer.data() : end;
+    if (newline == nullptr && start == end) { return false; }
+
+    parse(string_view(buffer.data() + start, lineEnd - start), record);
+    record.terminated = newline != nullptr;
+    record.lineNumber = ++lineNumber;
+    record.offset = bufferOffset + start;
+    start = (newline != nullptr) ? lineEnd + 1 : end;
+    return true;
+}
@@ -0,0 +1,84 @@
+#ifndef RECORD_READER_H
+#define RECORD_READER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+using namespace std;
+
+/**
+ * The fields of one line of a saved cubes file, which view the reader's buffer until the next line is read.
+ */
+struct RecordView {
+    string_view line;       // The line without its newline
+    string_view name;
+    string_view scramble;   // May still contain spaces, which are ignored by MoveParser
+    string_view moves;
+    string_view snapshot;   // Empty if the line has none
+    int totalMoves;
+    bool valid;             // Whether or not every required field could be read
+    bool terminated;        // Whether or not the line ends with a newline
+    long long lineNumber;   // Starting from 1
+    long long offset;       // The position of the line in the file
+
+    /**
+     * Checks if the line only holds whitespace.
+     * @return Whether or not the line is blank.
+     */
+    bool checkBlank() const;
+};
+
+/**
+ * Reads a saved cubes file one line at a time through a fixed-size buffer, so files of any size are read in constant memory.
+ * The buffer only grows if a single line is longer than it.
+ */
+class RecordReader {
+public:
+    static const int BUFFER_SIZE = 1 << 16;
+
+    /**
+     * Splits a line into the fields of a Cube (name, scramble, moves, total moves, and an optional snapshot).
+     * @param line The line to split.
+     * @param record The record, whose fields will view the line.
+     * @return Whether or not every required field could be read.
+     */
+    static bool parse(string_view line, RecordView& record);
+
+    /**
+     * Copies a field without its spaces.
+     * @param field The field to copy.
+     * @return The field without spaces.
+     */
+    static string removeSpaces(string_view field);
+
+    /**
+     * Constructor for RecordReader.
+     * @param fileName The name of the file to read.
+     * @param bufferSize The number of bytes read from the file at a time.
+     */
+    RecordReader(const string& fileName, int bufferSize = BUFFER_SIZE);
+
+    /**
+     * Checks if the file could be opened.
+     * @return Whether or not the file is open.
+     */
+    bool isOpen() const;
+
+    /**
+     * Reads the next line and splits it into fields.
+     * @param record The record, which will be updated and stays valid until the next call.
+     * @return Whether or not there was another line.
+     */
+    bool next(RecordView& record);
+private:
+    ifstream ifs;
+    vector<char> buffer;
+    size_t start;           // The first unread byte of the buffer
+    size_t end;             // One past the last byte read into the buffer
+    long long bufferOffset; // The position of the buffer's first byte in the file
+    long long lineNumber;
+    bool finished;
+};
+
+#endif
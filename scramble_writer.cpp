@@ -0,0 +1,80 @@
+#include "scramble_writer.h"
+#include "random_generator.h"
+#include "scrambler.h"
+#include "two_phase_solver.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+using namespace std;
+
+ScrambleWriter::ScrambleWriter(int numThreads) {
+    this->numThreads = max(numThreads, 1);
+}
+
+bool ScrambleWriter::writeFile(const string& fileName, long long count, uint64_t seed) {
+    vector<char> buffer(BUFFER_SIZE);
+    ofstream ofs;
+    ofs.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    ofs.open(fileName);
+    if (!ofs.is_open()) { return false; }
+
+    TwoPhaseSolver::initTables(); // Build the shared tables before the threads need them
+
+    // A few blocks per thread are generated at a time, which bounds memory and still balances uneven blocks.
+    const int CHUNK_BLOCKS = numThreads * 4;
+    long long numBlocks = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    RandomGenerator stream(seed);
+    vector<RandomGenerator> generators;
+    vector<string> blocks(CHUNK_BLOCKS);
+
+    for (long long firstBlock = 0; firstBlock < numBlocks; firstBlock += CHUNK_BLOCKS) {
+        int chunkSize = min((long long) CHUNK_BLOCKS, numBlocks - firstBlock);
+
+        // Each block starts where the previous block's stream was jumped past.
+        generators.clear();
+        for (int i = 0; i < chunkSize; i++) {
+            generators.push_back(stream);
+            stream.jump();
+        }
+
+        atomic<int> next(0);
+        auto work = [&]() {
+            for (int i = next++; i < chunkSize; i = next++) {
+                long long first = (firstBlock + i) * BLOCK_SIZE;
+                generateBlock(generators[i], first + 1, min((long long) BLOCK_SIZE, count - first), blocks[i]);
+            }
+        };
+
+        vector<thread> threads;
+        for (int t = 1; t < min(numThreads, chunkSize); t++) {
+            threads.emplace_back(work);
+        }
+
+        work();
+        for (thread& t : threads) {
+            t.join();
+        }
+
+        for (int i = 0; i < chunkSize; i++) {
+            ofs.write(blocks[i].data(), blocks[i].size());
+        }
+    }
+
+    ofs.close();
+    return !ofs.fail();
+}
+
+int ScrambleWriter::getThreads() const { return numThreads; }
+
+void ScrambleWriter::generateBlock(const RandomGenerator& generator, long long first, int count, string& lines) const {
+    Scrambler scrambler(generator);
+    lines.clear();
+
+    for (int i = 0; i < count; i++) {
+        lines += "scramble" + to_string(first + i) + ", " + scrambler.createScramble() + ", , 0\n";
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef SCRAMBLE_WRITER_H
+#define SCRAMBLE_WRITER_H
+
+#include "random_generator.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+using namespace std;
+
+/**
+ * Writes large numbers of random-state scrambles to a file in the format read by FileHandler, using a pool of threads.
+ * Scrambles are drawn in blocks, and each block has its own non-overlapping stream of the seed's generator,
+ * so a seed produces the same file no matter how many threads write it.
+ */
+class ScrambleWriter {
+public:
+    static const int BLOCK_SIZE = 256;         // The number of scrambles drawn from each stream
+    static const int BUFFER_SIZE = 1 << 20;    // The number of bytes written to the file at a time
+
+    /**
+     * Constructor for ScrambleWriter.
+     * @param numThreads The number of threads that generate scrambles, at least 1.
+     */
+    ScrambleWriter(int numThreads);
+
+    /**
+     * Writes one line per scramble ("scramble<number>, <scramble>, , 0"), numbered from 1 in the order of the streams.
+     * @param fileName The name of the file to write.
+     * @param count The number of scrambles.
+     * @param seed The seed of the random states.
+     * @return Whether or not the file could be written.
+     */
+    bool writeFile(const string& fileName, long long count, uint64_t seed);
+
+    /**
+     * Gets the number of threads that generate scrambles.
+     * @return The number of threads.
+     */
+    int getThreads() const;
+private:
+    /**
+     * Generates the lines of a block.
+     * @param generator The stream of the block.
+     * @param first The number of the first scramble.
+     * @param count The number of scrambles in the block.
+     * @param lines The text of the block, which will be updated.
+     */
+    void generateBlock(const RandomGenerator& generator, long long first, int count, string& lines) const;
+
+    int numThreads;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include "scrambler.h"
+#include "cubie_cube.h"
+#include "random_generator.h"
+#include "two_phase_solver.h"
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+using namespace std;
+
+Scrambler::Scrambler(uint64_t seed) : generator(seed) {}
+
+Scrambler::Scrambler(const RandomGenerator& generator) : generator(generator) {}
+
+CubieCube Scrambler::createRandomState() {
+    CubieCube state;
+    shuffle(state.cp, CubieCube::NUM_CORNERS);
+    shuffle(state.ep, CubieCube::NUM_EDGES);
+
+    // Swapping the last two edges pairs each odd arrangement with exactly one even one, so states stay uniform.
+    if (state.getCornerParity() != state.getEdgeParity()) {
+        swap(state.ep[CubieCube::NUM_EDGES - 2], state.ep[CubieCube::NUM_EDGES - 1]);
+    }
+
+    // Every orientation is free except the last, which makes the total twist and flip solvable.
+    int twist = 0;
+    for (int i = 0; i < CubieCube::NUM_CORNERS - 1; i++) {
+        state.co[i] = generator.nextBelow(3);
+        twist += state.co[i];
+    }
+    state.co[CubieCube::NUM_CORNERS - 1] = (3 - twist % 3) % 3;
+
+    int flip = 0;
+    for (int i = 0; i < CubieCube::NUM_EDGES - 1; i++) {
+        state.eo[i] = generator.nextBelow(2);
+        flip += state.eo[i];
+    }
+    state.eo[CubieCube::NUM_EDGES - 1] = flip % 2;
+
+    return state;
+}
+
+string Scrambler::createScramble(const CubieCube& state) {
+    // A solution of the inverse state turns a solved cube into the state itself.
+    pair<bool, string> res = solver.solve(state.getInverse(), TwoPhaseSolver::DEFAULT_MAX_LENGTH);
+    return res.first ? res.second : "";
+}
+
+string Scrambler::createScramble(CubieCube* state) {
+    // A state without a scramble (the solved state, or one the search gave up on) is replaced by the next random state.
+    while (true) {
+        CubieCube random = createRandomState();
+        string scramble = createScramble(random);
+
+        if (!scramble.empty()) {
+            if (state != nullptr) { *state = random; }
+            return scramble;
+        }
+    }
+}
+
+void Scrambler::shuffle(unsigned char* pieces, int size) {
+    for (int i = size - 1; i > 0; i--) {
+        swap(pieces[i], pieces[generator.nextBelow(i + 1)]);
+    }
+}
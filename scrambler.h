@@ -0,0 +1,61 @@
+#ifndef SCRAMBLER_H
+#define SCRAMBLER_H
+
+#include "cubie_cube.h"
+#include "random_generator.h"
+#include "two_phase_solver.h"
+#include <string>
+#include <cstdint>
+using namespace std;
+
+/**
+ * Generates scrambles of uniformly random states: every reachable arrangement of the pieces is equally likely.
+ * A state is drawn directly as random permutations and orientations, and its scramble is the two-phase solution of
+ * its inverse, so each scramble is about 20 moves long.
+ */
+class Scrambler {
+public:
+    /**
+     * Constructor for Scrambler.
+     * @param seed The seed of the random states, where the same seed always gives the same scrambles.
+     */
+    Scrambler(uint64_t seed);
+
+    /**
+     * Constructor for a Scrambler that continues the stream of a generator.
+     * @param generator The generator of the random states.
+     */
+    Scrambler(const RandomGenerator& generator);
+
+    /**
+     * Draws a uniformly random state that can be reached by turning the cube.
+     * @return The pieces of the state, with the default centers.
+     */
+    CubieCube createRandomState();
+
+    /**
+     * Finds a sequence of face turns that results in a state when applied to a solved cube.
+     * @param state The state to reach.
+     * @return The moves separated by spaces (empty if the state is solved), or an empty string if none was found.
+     */
+    string createScramble(const CubieCube& state);
+
+    /**
+     * Draws a uniformly random state and finds its scramble, drawing another state whenever none is found.
+     * @param state The state that the scramble results in, which will be updated if given.
+     * @return The moves separated by spaces, which never leave the cube solved.
+     */
+    string createScramble(CubieCube* state = nullptr);
+private:
+    /**
+     * Shuffles the pieces of a permutation in place (Fisher-Yates).
+     * @param pieces The pieces to shuffle.
+     * @param size The number of pieces.
+     */
+    void shuffle(unsigned char* pieces, int size);
+
+    RandomGenerator generator;
+    TwoPhaseSolver solver;
+};
+
+#endif
@@ -0,0 +1,163 @@
+#include "scrambler_tests.h"
+#include "tester.h"
+#include "scrambler.h"
+#include "random_generator.h"
+#include "scramble_writer.h"
+#include "file_handler.h"
+#include "cubie_cube.h"
+#include "cube.h"
+#include "move_parser.h"
+#include "two_phase_solver.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <set>
+#include <cstdio>
+using namespace std;
+
+int ScramblerTests::runTests() const {
+    Tester tester;
+
+    // Test that the same seed gives the same numbers
+    {
+        RandomGenerator generator1(42);
+        RandomGenerator generator2(42);
+        RandomGenerator generator3(43);
+        bool same = true;
+        bool different = false;
+
+        for (int i = 0; i < 100; i++) {
+            uint64_t value = generator1.next();
+            same = same && value == generator2.next();
+            different = different || value != generator3.next();
+        }
+
+        tester.test("The same seed gives the same numbers, and another seed does not", same && different);
+    }
+
+    // Test that a jump starts a different stream
+    {
+        RandomGenerator generator1(42);
+        RandomGenerator generator2(42);
+        generator2.jump();
+        tester.test("A jumped generator gives different numbers", generator1.next() != generator2.next());
+    }
+
+    // Test the range and spread of bounded numbers
+    {
+        RandomGenerator generator(7);
+        vector<int> counts(6, 0);
+        bool inRange = true;
+
+        for (int i = 0; i < 60000; i++) {
+            uint32_t value = generator.nextBelow(6);
+            inRange = inRange && value < 6;
+            if (value < 6) { counts[value]++; }
+        }
+
+        bool spread = true;
+        for (int count : counts) {
+            spread = spread && count > 9500 && count < 10500;
+        }
+
+        tester.test("Bounded numbers stay below the bound and are spread evenly", inRange && spread);
+    }
+
+    // Test that random states are valid and varied
+    {
+        Scrambler scrambler(1);
+        bool valid = true;
+        int oddCount = 0;
+        int twistedCount = 0;
+        const int SAMPLES = 2000;
+
+        for (int i = 0; i < SAMPLES; i++) {
+            CubieCube state = scrambler.createRandomState();
+            valid = valid && state.verify();
+            oddCount += state.getCornerParity();
+            twistedCount += state.co[0] != 0;
+        }
+
+        // Half of the states have odd permutations and two thirds have a twisted first corner
+        bool varied = oddCount > 900 && oddCount < 1100 && twistedCount > 1250 && twistedCount < 1420;
+        tester.test("Random states can be reached and have evenly spread parities and twists", valid && varied);
+    }
+
+    // Test that scrambles reach their states
+    {
+        Scrambler scrambler(2);
+        bool passed = true;
+
+        for (int i = 0; i < 20 && passed; i++) {
+            CubieCube state = scrambler.createRandomState();
+            string scramble = scrambler.createScramble(state);
+            Cube cube;
+            cube.doMoves(scramble, false);
+            passed = !scramble.empty() && cube.getCubieCube() == state;
+        }
+
+        tester.test("Applying a scramble to a solved cube results in its random state", passed);
+    }
+
+    // Test that generated scrambles are never empty and reach the state they were drawn for
+    {
+        Scrambler scrambler(4);
+        bool passed = true;
+
+        for (int i = 0; i < 50 && passed; i++) {
+            CubieCube state;
+            string scramble = scrambler.createScramble(&state);
+            Cube cube;
+            cube.doMoves(scramble, false);
+            passed = !scramble.empty() && !cube.checkSolved() && cube.getCubieCube() == state;
+        }
+
+        tester.test("Generated scrambles leave the cube unsolved, in the random state they were drawn for", passed);
+    }
+
+    // Test that scrambles are reproducible and short
+    {
+        Scrambler scrambler1(3);
+        Scrambler scrambler2(3);
+        string scramble1 = scrambler1.createScramble();
+        string scramble2 = scrambler2.createScramble();
+        vector<Move> moves;
+        MoveParser::parse(scramble1, &moves);
+        bool passed = scramble1 == scramble2 && !moves.empty() && moves.size() <= TwoPhaseSolver::DEFAULT_MAX_LENGTH;
+        tester.test("The same seed gives the same short scramble", passed);
+    }
+
+    // Test that written scrambles do not depend on the number of threads
+    {
+        const string FILE1 = "test_files/scrambles1.txt";
+        const string FILE2 = "test_files/scrambles2.txt";
+        const int COUNT = ScrambleWriter::BLOCK_SIZE + 4;
+        ScrambleWriter writer1(1);
+        ScrambleWriter writer3(3);
+        bool written = writer1.writeFile(FILE1, COUNT, 9) && writer3.writeFile(FILE2, COUNT, 9);
+
+        ifstream ifs1(FILE1);
+        ifstream ifs2(FILE2);
+        string line1, line2;
+        set<string> scrambles;
+        int lines = 0;
+        bool same = true;
+        bool scrambled = true;
+
+        while (getline(ifs1, line1)) {
+            same = same && getline(ifs2, line2) && line1 == line2;
+            scrambled = scrambled && line1.find(", , , 0") == string::npos; // A line without a scramble leaves the cube solved
+            scrambles.insert(line1.substr(line1.find(',')));
+            lines++;
+        }
+
+        bool valid = FileHandler(FILE1).checkValidFile(false) == FileHandler::VALID;
+        bool passed = written && same && valid && scrambled && lines == COUNT && scrambles.size() == COUNT;
+        tester.test("Written scrambles are valid, non-empty, distinct, and the same for any number of threads", passed);
+
+        remove(FILE1.c_str());
+        remove(FILE2.c_str());
+    }
+
+    return tester.finishTests();
+}
@@ -0,0 +1,13 @@
+#ifndef SCRAMBLER_TESTS_H
+#define SCRAMBLER_TESTS_H
+
+class ScramblerTests {
+public:
+    /**
+     * Runs Scrambler, RandomGenerator, and ScrambleWriter tests.
+     * @return 0 if they passed, 1 if they did not.
+     */
+    int runTests() const;
+};
+
+#endif
@@ -0,0 +1,343 @@
+#include "two_phase_solver.h"
+#include "cubie_cube.h"
+#include "coordinates.h"
+#include "facelet_moves.h"
+#include "move_parser.h"
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+using namespace std;
+
+namespace {
+    const int NUM_TWIST = 2187;        // 3^7 corner orientations
+    const int NUM_FLIP = 2048;         // 2^11 edge orientations
+    const int NUM_SLICE = 495;         // 12 choose 4 positions of the slice edges
+    const int NUM_CORNER_PERM = 40320; // 8! corner permutations
+    const int NUM_EDGE_PERM = 40320;   // 8! permutations of the edges outside the slice
+    const int NUM_SLICE_PERM = 24;     // 4! permutations of the slice edges
+    const int NUM_PHASE2_MOVES = 10;
+    const int FIRST_SLICE_EDGE = CubieCube::FR;
+
+    // The moves that keep a cube in the phase 2 subgroup: U, U2, U', D, D2, D', L2, F2, R2, and B2.
+    const int PHASE2_MOVES[NUM_PHASE2_MOVES] = { 0, 1, 2, 15, 16, 17, 4, 7, 10, 13 };
+
+    int getTwist(const CubieCube& cube) {
+        int res = 0;
+        for (int i = 0; i < CubieCube::NUM_CORNERS - 1; i++) {
+            res = res * 3 + cube.co[i];
+        }
+
+        return res;
+    }
+
+    void setTwist(CubieCube& cube, int twist) {
+        int total = 0;
+        for (int i = CubieCube::NUM_CORNERS - 2; i >= 0; i--) {
+            cube.co[i] = twist % 3;
+            total += cube.co[i];
+            twist /= 3;
+        }
+
+        // The last corner is determined by the others, since the twists always sum to a multiple of 3.
+        cube.co[CubieCube::NUM_CORNERS - 1] = (3 - total % 3) % 3;
+    }
+
+    int getFlip(const CubieCube& cube) {
+        int res = 0;
+        for (int i = 0; i < CubieCube::NUM_EDGES - 1; i++) {
+            res = res * 2 + cube.eo[i];
+        }
+
+        return res;
+    }
+
+    void setFlip(CubieCube& cube, int flip) {
+        int total = 0;
+        for (int i = CubieCube::NUM_EDGES - 2; i >= 0; i--) {
+            cube.eo[i] = flip % 2;
+            total += cube.eo[i];
+            flip /= 2;
+        }
+
+        cube.eo[CubieCube::NUM_EDGES - 1] = total % 2;
+    }
+
+    int getSlice(const CubieCube& cube) {
+        int res = 0;
+        int found = 0;
+
+        for (int i = CubieCube::NUM_EDGES - 1; i >= 0; i--) {
+            if (cube.ep[i] >= FIRST_SLICE_EDGE) {
+                res += Coordinates::choose(CubieCube::NUM_EDGES - 1 - i, found + 1);
+                found++;
+            }
+        }
+
+        return res;
+    }
+
+    void setSlice(CubieCube& cube, int slice) {
+        int sliceEdge = FIRST_SLICE_EDGE;
+        int otherEdge = 0;
+        int left = 4;
+
+        for (int i = 0; i < CubieCube::NUM_EDGES; i++) {
+            if (left > 0 && slice >= Coordinates::choose(CubieCube::NUM_EDGES - 1 - i, left)) {
+                slice -= Coordinates::choose(CubieCube::NUM_EDGES - 1 - i, left);
+                cube.ep[i] = sliceEdge++;
+                left--;
+            } else {
+                cube.ep[i] = otherEdge++;
+            }
+        }
+    }
+
+    struct Tables {
+        // Move tables, indexed by coordinate * number of moves + move.
+        vector<unsigned short> twistMoves;
+        vector<unsigned short> flipMoves;
+        vector<unsigned short> sliceMoves;
+        vector<unsigned short> cornerPermMoves;
+        vector<unsigned short> edgePermMoves;
+        vector<unsigned short> slicePermMoves;
+
+        // Pruning tables with the exact distance to the goal of each pair of coordinates.
+        vector<signed char> sliceTwistPrune;
+        vector<signed char> sliceFlipPrune;
+        vector<signed char> cornerPermPrune;
+        vector<signed char> edgePermPrune;
+    };
+
+    /**
+     * Builds the pruning table of a pair of coordinates with a breadth-first search from the solved pair.
+     * @param moves1 The move table of the first coordinate.
+     * @param size1 The number of values of the first coordinate.
+     * @param moves2 The move table of the second coordinate.
+     * @param size2 The number of values of the second coordinate.
+     * @param numMoves The number of moves in both tables.
+     * @return The number of moves needed to solve each pair, indexed by first * size2 + second.
+     */
+    vector<signed char> buildPruning(const vector<unsigned short>& moves1, int size1,
+                                     const vector<unsigned short>& moves2, int size2, int numMoves) {
+        vector<signed char> res(size1 * size2, -1);
+        res[0] = 0;
+        bool changed = true;
+
+        for (int depth = 0; changed; depth++) {
+            changed = false;
+
+            for (int i = 0; i < res.size(); i++) {
+                if (res[i] != depth) { continue; }
+
+                int coord1 = i / size2;
+                int coord2 = i % size2;
+
+                for (int move = 0; move < numMoves; move++) {
+                    int next = moves1[coord1 * numMoves + move] * size2 + moves2[coord2 * numMoves + move];
+
+                    if (res[next] == -1) {
+                        res[next] = depth + 1;
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        return res;
+    }
+
+    Tables buildTables() {
+        Tables tables;
+        const int NUM_MOVES = FaceletMoves::NUM_FACE_MOVES;
+
+        tables.twistMoves.resize(NUM_TWIST * NUM_MOVES);
+        for (int i = 0; i < NUM_TWIST; i++) {
+            for (int move = 0; move < NUM_MOVES; move++) {
+                CubieCube cube;
+                setTwist(cube, i);
+                cube.applyMove(move);
+                tables.twistMoves[i * NUM_MOVES + move] = getTwist(cube);
+            }
+        }
+
+        tables.flipMoves.resize(NUM_FLIP * NUM_MOVES);
+        for (int i = 0; i < NUM_FLIP; i++) {
+            for (int move = 0; move < NUM_MOVES; move++) {
+                CubieCube cube;
+                setFlip(cube, i);
+                cube.applyMove(move);
+                tables.flipMoves[i * NUM_MOVES + move] = getFlip(cube);
+            }
+        }
+
+        tables.sliceMoves.resize(NUM_SLICE * NUM_MOVES);
+        for (int i = 0; i < NUM_SLICE; i++) {
+            for (int move = 0; move < NUM_MOVES; move++) {
+                CubieCube cube;
+                setSlice(cube, i);
+                cube.applyMove(move);
+                tables.sliceMoves[i * NUM_MOVES + move] = getSlice(cube);
+            }
+        }
+
+        // Phase 2 coordinates are only defined within the subgroup, so only its moves are tabulated.
+        tables.cornerPermMoves.resize(NUM_CORNER_PERM * NUM_PHASE2_MOVES);
+        tables.edgePermMoves.resize(NUM_EDGE_PERM * NUM_PHASE2_MOVES);
+        for (int i = 0; i < NUM_CORNER_PERM; i++) {
+            for (int move = 0; move < NUM_PHASE2_MOVES; move++) {
+                CubieCube cube;
+                Coordinates::unrankPermutation(i, cube.cp, CubieCube::NUM_CORNERS, 0);
+                Coordinates::unrankPermutation(i, cube.ep, FIRST_SLICE_EDGE, 0);
+                cube.applyMove(PHASE2_MOVES[move]);
+                tables.cornerPermMoves[i * NUM_PHASE2_MOVES + move] = Coordinates::rankPermutation(cube.cp, CubieCube::NUM_CORNERS);
+                tables.edgePermMoves[i * NUM_PHASE2_MOVES + move] = Coordinates::rankPermutation(cube.ep, FIRST_SLICE_EDGE);
+            }
+        }
+
+        tables.slicePermMoves.resize(NUM_SLICE_PERM * NUM_PHASE2_MOVES);
+        for (int i = 0; i < NUM_SLICE_PERM; i++) {
+            for (int move = 0; move < NUM_PHASE2_MOVES; move++) {
+                CubieCube cube;
+                Coordinates::unrankPermutation(i, cube.ep + FIRST_SLICE_EDGE, 4, FIRST_SLICE_EDGE);
+                cube.applyMove(PHASE2_MOVES[move]);
+                tables.slicePermMoves[i * NUM_PHASE2_MOVES + move] = Coordinates::rankPermutation(cube.ep + FIRST_SLICE_EDGE, 4);
+            }
+        }
+
+        tables.sliceTwistPrune = buildPruning(tables.sliceMoves, NUM_SLICE, tables.twistMoves, NUM_TWIST, NUM_MOVES);
+        tables.sliceFlipPrune = buildPruning(tables.sliceMoves, NUM_SLICE, tables.flipMoves, NUM_FLIP, NUM_MOVES);
+        tables.cornerPermPrune = buildPruning(tables.slicePermMoves, NUM_SLICE_PERM, tables.cornerPermMoves, NUM_CORNER_PERM, NUM_PHASE2_MOVES);
+        tables.edgePermPrune = buildPruning(tables.slicePermMoves, NUM_SLICE_PERM, tables.edgePermMoves, NUM_EDGE_PERM, NUM_PHASE2_MOVES);
+
+        return tables;
+    }
+
+    const Tables& getTables() {
+        static const Tables TABLES = buildTables();
+        return TABLES;
+    }
+}
+
+void TwoPhaseSolver::initTables() {
+    getTables();
+}
+
+TwoPhaseSolver::TwoPhaseSolver() {
+    maxLength = DEFAULT_MAX_LENGTH;
+    length = -1;
+}
+
+pair<bool, string> TwoPhaseSolver::solve(const CubieCube& cube, int maxLength) {
+    initTables();
+    start = cube;
+    length = -1;
+    this->maxLength = min(maxLength, MAX_DEPTH - 1);
+
+    if (!cube.verify()) {
+        return { false, "" };
+    }
+
+    int twist = getTwist(cube);
+    int flip = getFlip(cube);
+    int slice = getSlice(cube);
+
+    for (int depth1 = 0; depth1 <= this->maxLength; depth1++) {
+        if (searchPhase1(twist, flip, slice, 0, depth1)) {
+            vector<Move> solution;
+
+            for (int i = 0; i < length; i++) {
+                solution.push_back(Move::fromIndex(moves[i]));
+            }
+
+            return { true, MoveParser::toString(solution, true) };
+        }
+    }
+
+    return { false, "" };
+}
+
+int TwoPhaseSolver::getLength() const { return length; }
+
+bool TwoPhaseSolver::searchPhase1(int twist, int flip, int slice, int depth, int togo) {
+    const Tables& tables = getTables();
+    const int NUM_MOVES = FaceletMoves::NUM_FACE_MOVES;
+
+    if (togo == 0) {
+        if (twist != 0 || flip != 0 || slice != 0) { return false; }
+
+        // If the last move is already in the subgroup, the shorter phase 1 was tried with a longer phase 2.
+        if (depth > 0) {
+            int last = moves[depth - 1];
+            if (last / 3 == 0 || last / 3 == 5 || last % 3 == 1) { return false; }
+        }
+
+        return startPhase2(depth);
+    }
+
+    int distance = max(tables.sliceTwistPrune[slice * NUM_TWIST + twist], tables.sliceFlipPrune[slice * NUM_FLIP + flip]);
+    if (distance > togo) { return false; }
+
+    for (int move = 0; move < NUM_MOVES; move++) {
+        if (!FaceletMoves::checkFollows(move, depth > 0 ? moves[depth - 1] : -1)) { continue; }
+
+        moves[depth] = move;
+        if (searchPhase1(tables.twistMoves[twist * NUM_MOVES + move], tables.flipMoves[flip * NUM_MOVES + move],
+                         tables.sliceMoves[slice * NUM_MOVES + move], depth + 1, togo - 1)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool TwoPhaseSolver::startPhase2(int depth1) {
+    CubieCube cube = start;
+    for (int i = 0; i < depth1; i++) {
+        cube.applyMove(moves[i]);
+    }
+
+    int cornerPerm = Coordinates::rankPermutation(cube.cp, CubieCube::NUM_CORNERS);
+    int edgePerm = Coordinates::rankPermutation(cube.ep, FIRST_SLICE_EDGE);
+    int slicePerm = Coordinates::rankPermutation(cube.ep + FIRST_SLICE_EDGE, 4);
+    int limit = min((int) MAX_PHASE2_LENGTH, maxLength - depth1);
+
+    // No phase 2 solution is shorter than the pruning tables' estimate, so the search starts there.
+    const Tables& tables = getTables();
+    int estimate = max(tables.cornerPermPrune[slicePerm * NUM_CORNER_PERM + cornerPerm],
+                       tables.edgePermPrune[slicePerm * NUM_EDGE_PERM + edgePerm]);
+
+    for (int depth2 = estimate; depth2 <= limit; depth2++) {
+        if (searchPhase2(cornerPerm, edgePerm, slicePerm, depth1, depth2)) {
+            length = depth1 + depth2;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool TwoPhaseSolver::searchPhase2(int cornerPerm, int edgePerm, int slicePerm, int depth, int togo) {
+    const Tables& tables = getTables();
+
+    if (togo == 0) {
+        return cornerPerm == 0 && edgePerm == 0 && slicePerm == 0;
+    }
+
+    int distance = max(tables.cornerPermPrune[slicePerm * NUM_CORNER_PERM + cornerPerm],
+                       tables.edgePermPrune[slicePerm * NUM_EDGE_PERM + edgePerm]);
+    if (distance > togo) { return false; }
+
+    for (int i = 0; i < NUM_PHASE2_MOVES; i++) {
+        int move = PHASE2_MOVES[i];
+        if (!FaceletMoves::checkFollows(move, depth > 0 ? moves[depth - 1] : -1)) { continue; }
+
+        moves[depth] = move;
+        if (searchPhase2(tables.cornerPermMoves[cornerPerm * NUM_PHASE2_MOVES + i], tables.edgePermMoves[edgePerm * NUM_PHASE2_MOVES + i],
+                         tables.slicePermMoves[slicePerm * NUM_PHASE2_MOVES + i], depth + 1, togo - 1)) {
+            return true;
+        }
+    }
+
+    return false;
+}
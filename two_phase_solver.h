@@ -0,0 +1,80 @@
+#ifndef TWO_PHASE_SOLVER_H
+#define TWO_PHASE_SOLVER_H
+
+#include "cubie_cube.h"
+#include <string>
+#include <utility>
+using namespace std;
+
+/**
+ * Solves a cube with Kociemba's two-phase algorithm: phase 1 reaches the subgroup generated by
+ * U, D, R2, L2, F2, and B2, and phase 2 solves the cube within that subgroup.
+ * The coordinate move tables and pruning tables are built once and shared by every solver.
+ */
+class TwoPhaseSolver {
+public:
+    static const int DEFAULT_MAX_LENGTH = 22;
+    static const int MAX_PHASE2_LENGTH = 18;
+
+    /**
+     * Builds the shared tables if they have not been built yet, which takes a moment the first time.
+     */
+    static void initTables();
+
+    /**
+     * Constructor for TwoPhaseSolver.
+     */
+    TwoPhaseSolver();
+
+    /**
+     * Finds a sequence of face turns that solves a cube in its current orientation.
+     * @param cube The pieces of the cube to solve.
+     * @param maxLength The maximum number of face turns (double turns count once) in the solution.
+     * @return Whether or not a solution was found, and the moves separated by spaces (empty if already solved).
+     */
+    pair<bool, string> solve(const CubieCube& cube, int maxLength);
+
+    /**
+     * Gets the number of face turns in the last solution.
+     * @return The length of the last solution, -1 if none was found.
+     */
+    int getLength() const;
+private:
+    static const int MAX_DEPTH = 31;
+
+    /**
+     * Searches for phase 1 solutions with exactly the remaining number of moves, then tries to finish each with phase 2.
+     * @param twist The corner orientation coordinate.
+     * @param flip The edge orientation coordinate.
+     * @param slice The coordinate of the positions of the slice edges.
+     * @param depth The number of moves made so far.
+     * @param togo The number of moves left in phase 1.
+     * @return Whether or not a full solution was found.
+     */
+    bool searchPhase1(int twist, int flip, int slice, int depth, int togo);
+
+    /**
+     * Sets up phase 2 from the pieces reached by the current phase 1 moves and searches for the shortest ending.
+     * @param depth1 The length of the phase 1 moves.
+     * @return Whether or not a full solution was found.
+     */
+    bool startPhase2(int depth1);
+
+    /**
+     * Searches for phase 2 solutions with exactly the remaining number of moves.
+     * @param cornerPerm The corner permutation coordinate.
+     * @param edgePerm The permutation coordinate of the edges outside the slice.
+     * @param slicePerm The permutation coordinate of the slice edges.
+     * @param depth The number of moves made so far.
+     * @param togo The number of moves left in phase 2.
+     * @return Whether or not a full solution was found.
+     */
+    bool searchPhase2(int cornerPerm, int edgePerm, int slicePerm, int depth, int togo);
+
+    CubieCube start;
+    int maxLength;
+    int length;
+    int moves[MAX_DEPTH];
+};
+
+#endif
@@ -0,0 +1,61 @@
+#include "two_phase_solver_tests.h"
+#include "tester.h"
+#include "two_phase_solver.h"
+#include "cubie_cube.h"
+#include "cube.h"
+#include <string>
+#include <utility>
+using namespace std;
+
+int TwoPhaseSolverTests::runTests() const {
+    Tester tester;
+
+    // Test solving a solved cube
+    {
+        TwoPhaseSolver solver;
+        pair<bool, string> res = solver.solve(CubieCube(), TwoPhaseSolver::DEFAULT_MAX_LENGTH);
+        tester.test("A solved cube is solved with no moves", res.first && res.second == "" && solver.getLength() == 0);
+    }
+
+    // Test solving a short scramble
+    {
+        Cube cube;
+        cube.doMoves("RUR'U'", false);
+        TwoPhaseSolver solver;
+        pair<bool, string> res = solver.solve(cube.getCubieCube(), TwoPhaseSolver::DEFAULT_MAX_LENGTH);
+        cube.doMoves(res.second, false);
+        tester.test("A short scramble is solved", res.first && solver.getLength() <= TwoPhaseSolver::DEFAULT_MAX_LENGTH && cube.checkSolved());
+    }
+
+    // Test solving a long scramble
+    {
+        Cube cube;
+        cube.doMoves("F2 D' B U2 L' R2 D F' U R2 B' L2 U' D2 F R' B2 U L D' F2 R B' L2 U2", false);
+        TwoPhaseSolver solver;
+        pair<bool, string> res = solver.solve(cube.getCubieCube(), TwoPhaseSolver::DEFAULT_MAX_LENGTH);
+        cube.doMoves(res.second, false);
+        bool passed = res.first && solver.getLength() <= TwoPhaseSolver::DEFAULT_MAX_LENGTH && cube.checkSolved();
+        tester.test("A long scramble is solved within the default maximum length", passed);
+    }
+
+    // Test solving a rotated cube
+    {
+        Cube cube;
+        cube.doMoves("xR2 F'yD B2 z'L", false);
+        TwoPhaseSolver solver;
+        pair<bool, string> res = solver.solve(cube.getCubieCube(), TwoPhaseSolver::DEFAULT_MAX_LENGTH);
+        cube.doMoves(res.second, false);
+        tester.test("A rotated cube is solved in its current orientation", res.first && cube.checkSolved());
+    }
+
+    // Test solving an impossible cube
+    {
+        CubieCube cubie;
+        cubie.co[0] = 1; // A single twisted corner cannot be reached by turning
+        TwoPhaseSolver solver;
+        pair<bool, string> res = solver.solve(cubie, TwoPhaseSolver::DEFAULT_MAX_LENGTH);
+        tester.test("An unreachable cube is reported as unsolvable", !res.first && solver.getLength() == -1);
+    }
+
+    return tester.finishTests();
+}
@@ -0,0 +1,13 @@
+#ifndef TWO_PHASE_SOLVER_TESTS_H
+#define TWO_PHASE_SOLVER_TESTS_H
+
+class TwoPhaseSolverTests {
+public:
+    /**
+     * Runs TwoPhaseSolver tests.
+     * @return 0 if they passed, 1 if they did not.
+     */
+    int runTests() const;
+};
+
+#endif